@@ -0,0 +1,139 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+#ifndef INCLUDE_SCHIFRA_CPU_FEATURES_HPP
+#define INCLUDE_SCHIFRA_CPU_FEATURES_HPP
+
+
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+
+
+/*
+  The vectorised kernels are built for x86 with GCC compatible compilers,
+  using per function target attributes, hence without any ISA flags upon
+  the command line. Defining NO_CPU_DISPATCH restricts the library to the
+  scalar kernels.
+*/
+#if !defined(NO_CPU_DISPATCH) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+   #define SCHIFRA_X86_DISPATCH
+#endif
+
+
+namespace schifra
+{
+
+   namespace cpu
+   {
+
+      enum level
+      {
+         scalar = 0,
+         ssse3  = 1,
+         avx2   = 2,
+         gfni   = 3   // GFNI together with AVX2
+      };
+
+      inline std::string to_string(const level l)
+      {
+         switch (l)
+         {
+            case scalar : return "scalar";
+            case ssse3  : return "ssse3";
+            case avx2   : return "avx2";
+            case gfni   : return "gfni";
+            default     : return "unknown";
+         }
+      }
+
+      inline bool from_string(const std::string& level_name, level& l)
+      {
+         const level level_list[] = { scalar, ssse3, avx2, gfni };
+
+         for (std::size_t i = 0; i < (sizeof(level_list) / sizeof(level)); ++i)
+         {
+            if (to_string(level_list[i]) == level_name)
+            {
+               l = level_list[i];
+               return true;
+            }
+         }
+
+         return false;
+      }
+
+      inline level detected_level()
+      {
+         /*
+           The highest level supported by both the processor and the
+           operating system (as per cpuid and the enabled xsave state).
+         */
+
+         #if defined(SCHIFRA_X86_DISPATCH)
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx2"))
+               return (__builtin_cpu_supports("gfni") ? gfni : avx2);
+            else if (__builtin_cpu_supports("ssse3"))
+               return ssse3;
+            else
+               return scalar;
+         #else
+            return scalar;
+         #endif
+      }
+
+      inline level select_level()
+      {
+         /*
+           The detected level, unless lowered by the environment variable
+           SCHIFRA_CPU_LEVEL (one of: scalar, ssse3, avx2 or gfni) which is
+           intended for testing the kernels of each level upon the one
+           machine. A level beyond that detected is never selected.
+         */
+
+         const level detected = detected_level();
+
+         const char* level_name = std::getenv("SCHIFRA_CPU_LEVEL");
+
+         level forced = detected;
+
+         if ((0 != level_name) && from_string(level_name, forced) && (forced < detected))
+         {
+            return forced;
+         }
+
+         return detected;
+      }
+
+      inline level active_level()
+      {
+         static const level active = select_level();
+         return active;
+      }
+
+   } // namespace cpu
+
+} // namespace schifra
+
+#endif
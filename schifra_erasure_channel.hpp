@@ -24,9 +24,15 @@
 #define INCLUDE_SCHIFRA_ERASURE_CHANNEL_HPP
 
 
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "schifra_galois_field_region.hpp"
 #include "schifra_reed_solomon_block.hpp"
 #include "schifra_reed_solomon_encoder.hpp"
 #include "schifra_reed_solomon_decoder.hpp"
+#include "schifra_reed_solomon_erasure_recovery.hpp"
 #include "schifra_reed_solomon_interleaving.hpp"
 #include "schifra_utilities.hpp"
 
@@ -61,18 +67,41 @@ namespace schifra
       inline bool erasure_channel_stack_encode(const encoder<code_length,fec_length>& encoder,
                                                      block<code_length,fec_length> (&output)[code_length])
       {
+         // Each row is encoded while in cache for the interleaving
+         if (!encode_and_interleave(encoder,output))
+         {
+            std::cout << "erasure_channel_stack_encode() - Error: Failed to encode stack" << std::endl;
+
+            return false;
+         }
+
+         return true;
+      }
+
+      template <std::size_t code_length, std::size_t fec_length>
+      inline bool erasure_channel_stack_column_encode(const encoder<code_length,fec_length>& encoder,
+                                                            block<code_length,fec_length> (&output)[code_length])
+      {
+         /*
+           The codewords are the stack's columns, encoded in place by way of
+           strided views: the leading data_length rows are the data, as sent,
+           and the encoder fills in the trailing fec_length rows. This is the
+           layout erasure_channel_stack_encode produces, less the transpose -
+           though the data is to be loaded row-wise into the leading rows.
+         */
+
          for (std::size_t i = 0; i < code_length; ++i)
          {
-            if (!encoder.encode(output[i]))
+            block_column_view<code_length,fec_length> column = column_view(output,i);
+
+            if (!encoder.encode(column))
             {
-               std::cout << "erasure_channel_stack_encode() - Error: Failed to encode block[" << i <<"]" << std::endl;
+               std::cout << "erasure_channel_stack_column_encode() - Error: Failed to encode column[" << i <<"]" << std::endl;
 
                return false;
             }
          }
 
-         interleave<code_length,fec_length>(output);
-
          return true;
       }
 
@@ -83,113 +112,436 @@ namespace schifra
 
          typedef decoder<code_length,fec_length,data_length> decoder_type;
          typedef typename decoder_type::block_type block_type;
-         typedef std::vector<galois::field_polynomial> polynomial_list_type;
+
+         /*
+           Erasure only decoding of a stack of codewords which all share the
+           one set of erasures, eg: the columns of an erasure channel stack
+           from which whole rows have gone missing. With X(p) = alpha^(n-1-p)
+           the locator of position p and b the generator's initial index,
+           the first m syndromes of a codeword c determine its m erased
+           symbols E from the known symbols K:
+
+              sum[e in E] X(e)^(b+r) * c[e] = sum[k in K] X(k)^(b+r) * c[k]
+
+           for r = 0..m-1. The m x m submatrix on the left is a (scaled)
+           Vandermonde matrix, whose inverse is given by the Lagrange basis
+           over the X(e). Hence c[E] = R * c[K], with P the erasure locator
+           polynomial prod[e in E](x + X(e)) (see details::erasure_recovery,
+           all known positions being the sources):
+
+              R[e][k] = (X(k) / X(e))^b * P(X(k)) / ((X(k) + X(e)) * P'(X(e)))
+
+           R is computed once per loss pattern, and each erased row of the
+           stack is then the sum of the known rows scaled by its row of R,
+           that is region multiply-accumulates across all codewords at once.
+           Any number of erasures from 1 to fec_length may be recovered.
+         */
 
          erasure_code_decoder(const galois::field& gfield,
                               const unsigned int& gen_initial_index)
-         : decoder<code_length,fec_length,data_length>(gfield, gen_initial_index)
+         : decoder<code_length,fec_length,data_length>(gfield, gen_initial_index),
+           recovery_(gfield, code_length, code_length - fec_length, gen_initial_index),
+           multiplier_(gfield)
+         {}
+
+         struct workspace
+         {
+            /*
+              The erasure state of the current loss pattern, and the byte
+              stack the rows are narrowed into. Owned by the caller and
+              reused across calls (one per thread), so that the one decoder
+              may be shared by any number of threads, and a stream of stacks
+              suffering the same loss pattern has the state computed but
+              once. The state being the sorted erasures, the remaining known
+              positions, X(e)^b * P'(X(e)) per erasure, X(p)^b * P(X(p)) per
+              position,
+              and R - one row of code_length coefficients per erasure, zero
+              at the erased positions.
+            */
+
+            std::vector<std::size_t>          erasure_key;
+            std::vector<std::size_t>          erasures;
+            std::vector<std::size_t>          known;
+            std::vector<galois::field_symbol> derivative;
+            std::vector<galois::field_symbol> weight;
+            std::vector<galois::field_symbol> coefficient;
+            std::vector<unsigned char>        buffer;
+         };
+
+         template <typename T>
+         bool decode_stack(block<code_length,fec_length,data_length,T> stack[code_length],
+                           const erasure_locations_t& missing_row_index) const
+         {
+            workspace ws;
+            return decode_stack(stack, missing_row_index, ws);
+         }
+
+         template <typename T>
+         bool decode_stack(block<code_length,fec_length,data_length,T> stack[code_length],
+                           const erasure_locations_t& missing_row_index,
+                           workspace& ws) const
+         {
+            /*
+              The stack as received: row i holds symbol i of every codeword,
+              the codewords being the columns. The missing rows are restored
+              in place, and the stack is left untransposed.
+            */
+
+            if (!prepare_erasure_state(missing_row_index, ws))
+            {
+               return false;
+            }
+
+            return decode_stack(stack, ws);
+         }
+
+         template <typename T>
+         bool decode_stack(block<code_length,fec_length,data_length,T> stack[code_length], workspace& ws) const
          {
+            // The missing rows being those reported to the workspace by way of add_erasure
+            if (!decoder_type::decoder_valid_)
+            {
+               return false;
+            }
+
+            if (ws.erasures.empty())
+            {
+               return true;
+            }
+
+            T* row[code_length];
+
             for (std::size_t i = 0; i < code_length; ++i)
             {
-               received_.push_back(galois::field_polynomial(decoder_type::field_, code_length - 1));
-               syndrome_.push_back(galois::field_polynomial(decoder_type::field_));
+               row[i] = stack[i].data;
             }
-         };
+
+            recover_rows(row, ws);
+
+            return true;
+         }
 
          bool decode(block_type rsblock[code_length], const erasure_locations_t& erasure_list) const
+         {
+            workspace ws;
+            return decode(rsblock, erasure_list, ws);
+         }
+
+         bool decode(block_type rsblock[code_length], const erasure_locations_t& erasure_list, workspace& ws) const
+         {
+            // The codewords are the rows, hence the stack is worked upon transposed
+            if (!prepare_erasure_state(erasure_list, ws))
+            {
+               return false;
+            }
+
+            if (erasure_list.empty())
+            {
+               return true;
+            }
+
+            typename block_type::symbol_type* row[code_length];
+
+            for (std::size_t i = 0; i < code_length; ++i)
+            {
+               row[i] = rsblock[i].data;
+            }
+
+            details::transpose(row, code_length);
+
+            recover_rows(row, ws);
+
+            details::transpose(row, code_length);
+
+            return true;
+         }
+
+         /*
+           For a receiver that learns of its losses one at a time (eg: by
+           gaps in the packet sequence numbers), the erasure state may be
+           built up as each loss is reported: adding the m-th erasure
+           rescales the m - 1 rows of R already present, as P(X(k)) gains
+           the factor X(k) + X(m) and P'(X(e)) the factor X(e) + X(m), and
+           appends the row of the new erasure - O(m * n) all told. Once the
+           window closes, decode_stack(stack,ws) is the one multiply
+           accumulate pass.
+         */
+
+         void clear_erasures(workspace& ws) const
+         {
+            ws.erasures   .clear();
+            ws.derivative .clear();
+            ws.coefficient.clear();
+            ws.known .resize(code_length);
+            ws.weight.resize(code_length);
+
+            for (std::size_t p = 0; p < code_length; ++p)
+            {
+               ws.known [p] = p;
+               ws.weight[p] = recovery_.initial_power(p);
+            }
+         }
+
+         bool add_erasure(const std::size_t missing_row, workspace& ws) const
          {
             if (
                  (!decoder_type::decoder_valid_) ||
-                 (erasure_list.size() != fec_length)
+                 (missing_row >= code_length)
                )
             {
                return false;
             }
 
-            for (std::size_t i = 0; i < code_length; ++i)
+            if ((ws.known.size() + ws.erasures.size()) != code_length)
             {
-               decoder_type::load_message    (received_[i], rsblock  [i]);
-               decoder_type::compute_syndrome(received_[i], syndrome_[i]);
+               clear_erasures(ws);
             }
 
-            erasure_locations_t erasure_locations;
-            decoder_type::prepare_erasure_list(erasure_locations,erasure_list);
+            const std::vector<std::size_t>::iterator erasure = std::lower_bound(ws.erasures.begin(), ws.erasures.end(), missing_row);
 
-            galois::field_polynomial gamma(galois::field_element(decoder_type::field_, 1));
+            if (
+                 ((erasure != ws.erasures.end()) && (*erasure == missing_row)) ||
+                 (ws.erasures.size() == fec_length)
+               )
+            {
+               return false;
+            }
 
-            decoder_type::compute_gamma(gamma,erasure_locations);
+            const galois::field& field = decoder_type::field_;
 
-            std::vector<int> gamma_roots;
+            const std::size_t          index         = static_cast<std::size_t>(erasure - ws.erasures.begin());
+            const std::size_t          erasure_count = ws.erasures.size();
+            const galois::field_symbol x             = recovery_.locator(missing_row);
 
-            find_roots_in_data(gamma,gamma_roots);
+            ws.erasures.insert(erasure, missing_row);
+            ws.known.erase(std::lower_bound(ws.known.begin(), ws.known.end(), missing_row));
+            ws.weight[missing_row] = 0;
 
-            polynomial_list_type omega;
+            const std::size_t known_count = ws.known.size();
 
-            for (std::size_t i = 0; i < code_length; ++i)
+            galois::field_symbol derivative = recovery_.initial_power(missing_row);
+
+            for (std::size_t i = 0; i < erasure_count; ++i)
+            {
+               const std::size_t          j          = (i < index) ? i : i + 1;
+               const galois::field_symbol difference = recovery_.locator(ws.erasures[j]) ^ x;
+               const galois::field_symbol scale      = field.inverse(difference);
+               galois::field_symbol*      r          = &ws.coefficient[i * code_length];
+
+               for (std::size_t k = 0; k < known_count; ++k)
+               {
+                  const std::size_t position = ws.known[k];
+                  r[position] = field.mul(field.mul(r[position], recovery_.locator(position) ^ x), scale);
+               }
+
+               r[missing_row] = 0;
+
+               ws.derivative[i] = field.mul(ws.derivative[i], difference);
+               derivative       = field.mul(derivative, difference);
+            }
+
+            for (std::size_t k = 0; k < known_count; ++k)
             {
-               omega.push_back((gamma * syndrome_[i]) % fec_length);
+               const std::size_t position = ws.known[k];
+               ws.weight[position] = field.mul(ws.weight[position], recovery_.locator(position) ^ x);
             }
 
-            galois::field_polynomial gamma_derivative = gamma.derivative();
+            ws.derivative.insert(ws.derivative.begin() + index, derivative);
+            ws.coefficient.insert(ws.coefficient.begin() + (index * code_length), code_length, galois::field_symbol(0));
+
+            fill_recovery_row(index, ws);
+
+            return true;
+         }
+
+      private:
+
+         bool prepare_erasure_state(const erasure_locations_t& erasure_list, workspace& ws) const
+         {
+            /*
+              Note: The erasure positions must be unique and exist within
+                    the code block, the order in which they are listed is
+                    of no consequence.
+            */
 
-            for (std::size_t i = 0; i < gamma_roots.size(); ++i)
+            if (
+                 (!decoder_type::decoder_valid_)      ||
+                 (erasure_list.size() > fec_length)
+               )
             {
-               int error_location                  = static_cast<int>(gamma_roots[i]);
-               galois::field_symbol  alpha_inverse = decoder_type::field_.alpha(error_location);
-               galois::field_element denominator   = gamma_derivative(alpha_inverse);
+               return false;
+            }
+
+            ws.erasure_key.assign(erasure_list.begin(), erasure_list.end());
+
+            std::sort(ws.erasure_key.begin(), ws.erasure_key.end());
 
-               if (denominator == 0)
+            for (std::size_t i = 0; i < ws.erasure_key.size(); ++i)
+            {
+               if (
+                    (ws.erasure_key[i] >= code_length) ||
+                    ((i > 0) && (ws.erasure_key[i] == ws.erasure_key[i - 1]))
+                  )
                {
                   return false;
                }
+            }
 
-               for (std::size_t j = 0; j < code_length; ++j)
-               {
-                  galois::field_element numerator = (omega[j](alpha_inverse) * decoder_type::root_exponent_table_[error_location]);
-                  /*
-                    A minor optimization can be made in the event the
-                    numerator is equal to zero by not executing the
-                    following line.
-                  */
-                  rsblock[j][error_location - 1] ^= decoder_type::field_.div(numerator.poly(),denominator.poly());
-               }
+            if (
+                 (ws.erasure_key == ws.erasures) &&
+                 ((ws.known.size() + ws.erasures.size()) == code_length)
+               )
+            {
+               return true;
             }
 
+            ws.erasures.swap(ws.erasure_key);
+
+            build_erasure_state(ws);
+
             return true;
          }
 
-      private:
+         void build_erasure_state(workspace& ws) const
+         {
+            // The whole of the state at once, for the sorted erasures
+            const std::size_t erasure_count = ws.erasures.size();
+
+            ws.known.clear();
+
+            for (std::size_t p = 0, e = 0; p < code_length; ++p)
+            {
+               if ((e < erasure_count) && (ws.erasures[e] == p))
+                  ++e;
+               else
+                  ws.known.push_back(p);
+            }
 
-         void find_roots_in_data(const galois::field_polynomial& poly, std::vector<int>& root_list) const
+            ws.derivative.resize(erasure_count);
+
+            for (std::size_t i = 0; i < erasure_count; ++i)
+            {
+               ws.derivative[i] = recovery_.weight(ws.erasures[i], ws.erasures);
+            }
+
+            ws.weight.assign(code_length, 0);
+
+            for (std::size_t k = 0; k < ws.known.size(); ++k)
+            {
+               ws.weight[ws.known[k]] = recovery_.weight(ws.known[k], ws.erasures);
+            }
+
+            ws.coefficient.assign(erasure_count * code_length, 0);
+
+            for (std::size_t i = 0; i < erasure_count; ++i)
+            {
+               fill_recovery_row(i, ws);
+            }
+         }
+
+         void fill_recovery_row(const std::size_t index, workspace& ws) const
+         {
+            // R[e][k] = X(k)^b * P(X(k)) / ((X(k) + X(e)) * X(e)^b * P'(X(e)))
+            const std::size_t          erasure = ws.erasures[index];
+            const galois::field_symbol x       = recovery_.locator(erasure);
+            const galois::field_symbol scale   = decoder_type::field_.inverse(ws.derivative[index]);
+            galois::field_symbol*      r       = &ws.coefficient[index * code_length];
+
+            for (std::size_t k = 0; k < ws.known.size(); ++k)
+            {
+               const std::size_t position = ws.known[k];
+               r[position] = recovery_.coefficient(ws.weight[position], position, x, scale);
+            }
+         }
+
+         inline void recover_rows(unsigned char* row[], workspace& ws) const
+         {
+            if (!multiplier_.valid())
+            {
+               recover_rows_scalar(row, ws);
+               return;
+            }
+
+            const std::size_t known_count = ws.known.size();
+
+            for (std::size_t i = 0; i < ws.erasures.size(); ++i)
+            {
+               const galois::field_symbol* r   = &ws.coefficient[i * code_length];
+               unsigned char*              dst = row[ws.erasures[i]];
+
+               multiplier_.multiply(static_cast<unsigned char>(r[ws.known[0]]), row[ws.known[0]], dst, code_length);
+
+               for (std::size_t k = 1; k < known_count; ++k)
+               {
+                  multiplier_.multiply_add(static_cast<unsigned char>(r[ws.known[k]]), row[ws.known[k]], dst, code_length);
+               }
+            }
+         }
+
+         template <typename T>
+         inline void recover_rows(T* row[], workspace& ws) const
          {
             /*
-               Chien Search, as described in parent, but only
-               for locations within the data range of the message.
+              Symbols wider than a byte, of a field of up to 2^8 elements,
+              are narrowed into a byte stack so as to use the region kernels,
+              the restored rows being widened back.
             */
-            root_list.reserve(fec_length << 1);
-            root_list.resize(0);
 
-            std::size_t polynomial_degree = poly.deg();
-            std::size_t root_list_size = 0;
+            if (!multiplier_.valid())
+            {
+               recover_rows_scalar(row, ws);
+               return;
+            }
+
+            ws.buffer.resize(code_length * code_length);
+
+            unsigned char* byte_row[code_length];
+
+            for (std::size_t i = 0; i < code_length; ++i)
+            {
+               byte_row[i] = &ws.buffer[i * code_length];
+            }
 
-            for (int i = 1; i <= static_cast<int>(data_length); ++i)
+            for (std::size_t k = 0; k < ws.known.size(); ++k)
             {
-               if (0 == poly(decoder_type::field_.alpha(i)).poly())
+               std::copy(row[ws.known[k]], row[ws.known[k]] + code_length, byte_row[ws.known[k]]);
+            }
+
+            recover_rows(byte_row, ws);
+
+            for (std::size_t i = 0; i < ws.erasures.size(); ++i)
+            {
+               std::copy(byte_row[ws.erasures[i]], byte_row[ws.erasures[i]] + code_length, row[ws.erasures[i]]);
+            }
+         }
+
+         template <typename T>
+         inline void recover_rows_scalar(T* row[], const workspace& ws) const
+         {
+            const galois::field& field       = decoder_type::field_;
+            const std::size_t    known_count = ws.known.size();
+
+            for (std::size_t i = 0; i < ws.erasures.size(); ++i)
+            {
+               const galois::field_symbol* r   = &ws.coefficient[i * code_length];
+               T*                          dst = row[ws.erasures[i]];
+
+               for (std::size_t c = 0; c < code_length; ++c)
                {
-                  root_list.push_back(i);
-                  root_list_size++;
+                  galois::field_symbol sum = 0;
 
-                  if (root_list_size == polynomial_degree)
+                  for (std::size_t k = 0; k < known_count; ++k)
                   {
-                     break;
+                     sum ^= field.mul(r[ws.known[k]], static_cast<galois::field_symbol>(row[ws.known[k]][c]));
                   }
+
+                  dst[c] = static_cast<T>(sum);
                }
             }
          }
 
-         mutable polynomial_list_type received_;
-         mutable polynomial_list_type syndrome_;
-
+         const details::erasure_recovery recovery_;
+         const galois::region_multiplier multiplier_;
       };
 
       template <std::size_t code_length, std::size_t fec_length>
@@ -202,13 +554,43 @@ namespace schifra
             return true;
          }
 
-         interleave<code_length,fec_length>(output);
+         // Each row is decoded as soon as the deinterleaving completes it
+         if (!deinterleave_and_decode(general_decoder,output,missing_row_index))
+         {
+            std::cout << "[2] erasure_channel_stack_decode() - Error: Failed to decode stack" << std::endl;
+
+            return false;
+         }
+
+         return true;
+      }
+
+      template <std::size_t code_length, std::size_t fec_length>
+      inline bool erasure_channel_stack_column_decode(const decoder<code_length,fec_length>& general_decoder,
+                                                      const erasure_locations_t& missing_row_index,
+                                                            block<code_length,fec_length> (&output)[code_length])
+      {
+         /*
+           The counterpart of erasure_channel_stack_column_encode: the stack's
+           columns are decoded in place, the missing rows being the erasures
+           of every column, and the stack is left as received - hence the
+           data is found in the leading data_length rows.
+         */
+
+         if (missing_row_index.empty())
+         {
+            return true;
+         }
+
+         typename decoder<code_length,fec_length>::workspace workspace;
 
          for (std::size_t i = 0; i < code_length; ++i)
          {
-            if (!general_decoder.decode(output[i],missing_row_index))
+            block_column_view<code_length,fec_length> column = column_view(output,i);
+
+            if (!general_decoder.decode(column,missing_row_index,workspace))
             {
-               std::cout << "[2] erasure_channel_stack_decode() - Error: Failed to decode block[" << i <<"]" << std::endl;
+               std::cout << "erasure_channel_stack_column_decode() - Error: Failed to decode column[" << i <<"]" << std::endl;
 
                return false;
             }
@@ -221,6 +603,17 @@ namespace schifra
       inline bool erasure_channel_stack_decode(const erasure_code_decoder<code_length,fec_length>& erasure_decoder,
                                                const erasure_locations_t& missing_row_index,
                                                      block<code_length,fec_length> (&output)[code_length])
+      {
+         typename erasure_code_decoder<code_length,fec_length>::workspace workspace;
+
+         return erasure_channel_stack_decode(erasure_decoder,missing_row_index,output,workspace);
+      }
+
+      template <std::size_t code_length, std::size_t fec_length>
+      inline bool erasure_channel_stack_decode(const erasure_code_decoder<code_length,fec_length>& erasure_decoder,
+                                               const erasure_locations_t& missing_row_index,
+                                                     block<code_length,fec_length> (&output)[code_length],
+                                                     typename erasure_code_decoder<code_length,fec_length>::workspace& workspace)
       {
          /*
            Note: 1. Missing row indicies must be unique.
@@ -235,17 +628,288 @@ namespace schifra
          {
             return true;
          }
-         else if (missing_row_index.size() == fec_length)
+
+         // The missing rows are restored before the transpose, across all codewords at once
+         if (!erasure_decoder.decode_stack(output,missing_row_index,workspace))
+         {
+            std::cout << "[3] erasure_channel_stack_decode() - Error: Failed to decode stack" << std::endl;
+
+            return false;
+         }
+
+         interleave<code_length,fec_length>(output);
+
+         return true;
+      }
+
+      template <std::size_t code_length, std::size_t fec_length>
+      class erasure_channel_stack_codec
+      {
+      public:
+
+         /*
+           An erasure channel stack of any depth: row_count rows (packets) of
+           block<code_length,fec_length>, where fec_length < row_count and
+           row_count <= code_length. Each of the code_length columns is a
+           codeword of the code shortened to row_count symbols - the leading
+           row_count - fec_length rows being the data, as sent, and the
+           trailing fec_length rows the parity. Hence up to fec_length
+           missing rows are recovered from a window of as few as
+           fec_length + 1 packets, the latency and memory of the stack
+           being traded against its overhead. The columns are encoded in
+           place by the encoder core sized for the shortened code. As all
+           columns share the one set of erasures, the missing rows are each
+           the sum of the first data_row_count rows present, scaled by the
+           recovery matrix of the shortened code for that set of missing
+           rows (see details::erasure_recovery) - region multiply
+           accumulates across all of the columns at once.
+         */
+
+         typedef block<code_length,fec_length> block_type;
+
+         struct workspace
+         {
+            /*
+              Owned by the caller and reused across calls (one per thread):
+              the recovery matrices of recent sets of missing rows, and the
+              byte rows that symbols wider than a byte are narrowed into.
+            */
+
+            details::erasure_recovery::cache recovery_cache;
+            std::vector<unsigned char>       buffer;
+         };
+
+         erasure_channel_stack_codec(const galois::field&            field,
+                                     const galois::field_polynomial& generator,
+                                     const unsigned int              gen_initial_index,
+                                     const std::size_t               row_count)
+         : row_count_(row_count),
+           encoder_(field, row_count, fec_length, generator),
+           recovery_(field, row_count, row_count - fec_length, gen_initial_index),
+           multiplier_(field)
+         {}
+
+         inline bool valid() const
+         {
+            return (row_count_ <= code_length) && encoder_.valid();
+         }
+
+         inline std::size_t row_count() const
+         {
+            return row_count_;
+         }
+
+         inline std::size_t data_row_count() const
+         {
+            return row_count_ - fec_length;
+         }
+
+         template <typename T>
+         inline bool encode(block<code_length,fec_length,code_length - fec_length,T> stack[]) const
+         {
+            if (!valid())
+               return false;
+
+            for (std::size_t i = 0; i < code_length; ++i)
+            {
+               block_column_view<code_length,fec_length,T> column(stack,i);
+
+               encoder_.encode(column);
+            }
+
+            return true;
+         }
+
+         template <typename T>
+         inline bool decode(const erasure_locations_t& missing_row_index,
+                            block<code_length,fec_length,code_length - fec_length,T> stack[]) const
+         {
+            workspace ws;
+            return decode(missing_row_index, stack, ws);
+         }
+
+         template <typename T>
+         inline bool decode(const erasure_locations_t& missing_row_index,
+                            block<code_length,fec_length,code_length - fec_length,T> stack[],
+                            workspace& ws) const
+         {
+            /*
+              Note: The missing row indicies must be unique and within the
+                    stack, and the rows present must be free of errors.
+            */
+
+            if (!valid())
+               return false;
+            else if (missing_row_index.empty())
+               return true;
+
+            const details::erasure_recovery::matrix* matrix = recovery_.lookup(missing_row_index, ws.recovery_cache);
+
+            if (0 == matrix)
+               return false;
+
+            recover_rows(stack, *matrix, ws);
+
+            return true;
+         }
+
+      private:
+
+         erasure_channel_stack_codec(const erasure_channel_stack_codec&);
+         erasure_channel_stack_codec& operator=(const erasure_channel_stack_codec&);
+
+         inline void combine(const unsigned char* const source[],
+                             unsigned char* const       target[],
+                             const details::erasure_recovery::matrix& matrix) const
+         {
+            const std::size_t source_count = matrix.sources.size();
+
+            for (std::size_t t = 0; t < matrix.erasure_count; ++t)
+            {
+               const galois::field_symbol* r = &matrix.coefficient[t * source_count];
+
+               multiplier_.multiply(static_cast<unsigned char>(r[0]), source[0], target[t], code_length);
+
+               for (std::size_t s = 1; s < source_count; ++s)
+               {
+                  multiplier_.multiply_add(static_cast<unsigned char>(r[s]), source[s], target[t], code_length);
+               }
+            }
+         }
+
+         inline void recover_rows(block<code_length,fec_length,code_length - fec_length,unsigned char> stack[],
+                                  const details::erasure_recovery::matrix& matrix,
+                                  workspace&) const
+         {
+            if (!multiplier_.valid())
+            {
+               recover_rows_scalar(stack, matrix);
+               return;
+            }
+
+            const unsigned char* source[code_length];
+            unsigned char*       target[code_length];
+
+            for (std::size_t s = 0; s < matrix.sources.size(); ++s)
+            {
+               source[s] = stack[matrix.sources[s]].data;
+            }
+
+            for (std::size_t t = 0; t < matrix.erasure_count; ++t)
+            {
+               target[t] = stack[matrix.erasures[t]].data;
+            }
+
+            combine(source, target, matrix);
+         }
+
+         template <typename T>
+         inline void recover_rows(block<code_length,fec_length,code_length - fec_length,T> stack[],
+                                  const details::erasure_recovery::matrix& matrix,
+                                  workspace& ws) const
+         {
+            /*
+              Symbols wider than a byte, of a field of up to 2^8 elements,
+              are narrowed into byte rows so as to use the region kernels,
+              the restored rows being widened back.
+            */
+
+            if (!multiplier_.valid())
+            {
+               recover_rows_scalar(stack, matrix);
+               return;
+            }
+
+            const std::size_t source_count = matrix.sources.size();
+            const std::size_t target_count = matrix.erasure_count;
+
+            ws.buffer.resize((source_count + target_count) * code_length);
+
+            const unsigned char* source[code_length];
+            unsigned char*       target[code_length];
+
+            for (std::size_t s = 0; s < source_count; ++s)
+            {
+               unsigned char* byte_row = &ws.buffer[s * code_length];
+               const T*       row      = stack[matrix.sources[s]].data;
+
+               std::copy(row, row + code_length, byte_row);
+
+               source[s] = byte_row;
+            }
+
+            for (std::size_t t = 0; t < target_count; ++t)
+            {
+               target[t] = &ws.buffer[(source_count + t) * code_length];
+            }
+
+            combine(source, target, matrix);
+
+            for (std::size_t t = 0; t < target_count; ++t)
+            {
+               std::copy(target[t], target[t] + code_length, stack[matrix.erasures[t]].data);
+            }
+         }
+
+         template <typename T>
+         inline void recover_rows_scalar(block<code_length,fec_length,code_length - fec_length,T> stack[],
+                                         const details::erasure_recovery::matrix& matrix) const
          {
-            interleave<code_length,fec_length>(output);
+            const galois::field& field        = recovery_.field();
+            const std::size_t    source_count = matrix.sources.size();
 
-            return erasure_decoder.decode(output,missing_row_index);
+            for (std::size_t t = 0; t < matrix.erasure_count; ++t)
+            {
+               const galois::field_symbol* r   = &matrix.coefficient[t * source_count];
+               T*                          dst = stack[matrix.erasures[t]].data;
+
+               for (std::size_t c = 0; c < code_length; ++c)
+               {
+                  galois::field_symbol sum = 0;
+
+                  for (std::size_t s = 0; s < source_count; ++s)
+                  {
+                     sum ^= field.mul(r[s], static_cast<galois::field_symbol>(stack[matrix.sources[s]].data[c]));
+                  }
+
+                  dst[c] = static_cast<T>(sum);
+               }
+            }
          }
-         else
-            return erasure_channel_stack_decode<code_length,fec_length>(
-                      static_cast<const decoder<code_length,fec_length>&>(erasure_decoder),
-                      missing_row_index,
-                      output);
+
+         const std::size_t               row_count_;
+         const details::encoder_core     encoder_;
+         const details::erasure_recovery recovery_;
+         const galois::region_multiplier multiplier_;
+      };
+
+      template <std::size_t code_length, std::size_t fec_length, typename T>
+      inline bool erasure_channel_stack_encode(const erasure_channel_stack_codec<code_length,fec_length>& codec,
+                                                     block<code_length,fec_length,code_length - fec_length,T> output[])
+      {
+         if (!codec.encode(output))
+         {
+            std::cout << "erasure_channel_stack_encode() - Error: Failed to encode stack of " << codec.row_count() << " rows" << std::endl;
+
+            return false;
+         }
+
+         return true;
+      }
+
+      template <std::size_t code_length, std::size_t fec_length, typename T>
+      inline bool erasure_channel_stack_decode(const erasure_channel_stack_codec<code_length,fec_length>& codec,
+                                               const erasure_locations_t& missing_row_index,
+                                                     block<code_length,fec_length,code_length - fec_length,T> output[])
+      {
+         if (!codec.decode(missing_row_index,output))
+         {
+            std::cout << "erasure_channel_stack_decode() - Error: Failed to decode stack of " << codec.row_count() << " rows" << std::endl;
+
+            return false;
+         }
+
+         return true;
       }
 
    } // namespace reed_solomon
@@ -0,0 +1,186 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+/*
+   Description: This example will demonstrate erasure channel stacks of fewer
+                rows than the code length, where each column of the stack is
+                a codeword of the shortened code. Windows of 16, 32 and 64
+                packets are encoded, up to fec_length packets are lost, and
+                the missing packets are recovered.
+*/
+
+
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "schifra_galois_field.hpp"
+#include "schifra_galois_field_polynomial.hpp"
+#include "schifra_sequential_root_generator_polynomial_creator.hpp"
+#include "schifra_reed_solomon_block.hpp"
+#include "schifra_erasure_channel.hpp"
+#include "schifra_utilities.hpp"
+
+
+template <std::size_t code_length, std::size_t fec_length>
+bool erasure_channel_window_test(const schifra::galois::field&            field,
+                                 const schifra::galois::field_polynomial& generator_polynomial,
+                                 const std::size_t                        generator_polynomial_index,
+                                 const std::size_t                        row_count,
+                                 const std::size_t                        max_iterations)
+{
+   typedef schifra::reed_solomon::erasure_channel_stack_codec<code_length,fec_length> codec_t;
+   typedef typename codec_t::block_type block_t;
+
+   const codec_t codec(field,generator_polynomial,static_cast<unsigned int>(generator_polynomial_index),row_count);
+
+   if (!codec.valid())
+   {
+      std::cout << "Error - Invalid erasure channel stack codec! rows: " << row_count << std::endl;
+      return false;
+   }
+
+   const std::size_t data_size = codec.data_row_count() * code_length;
+
+   std::vector<block_t>       block_stack(row_count);
+   std::vector<unsigned char> send_data  (data_size);
+
+   typename codec_t::workspace workspace;
+
+   schifra::utils::timer timer;
+   timer.start();
+
+   for (std::size_t iteration = 0; iteration < max_iterations; ++iteration)
+   {
+      /* The data rows are sent as is, the columns then being encoded */
+      for (std::size_t i = 0; i < data_size; ++i)
+      {
+         send_data[i] = static_cast<unsigned char>((i * 3 + 7 * iteration) & 0xFF);
+         block_stack[i / code_length][i % code_length] = send_data[i];
+      }
+
+      if (!codec.encode(&block_stack[0]))
+      {
+         std::cout << "Error - Failed to encode stack! rows: " << row_count << std::endl;
+         return false;
+      }
+
+      /* Add Erasures - Simulate network packet loss (e.g: UDP) */
+      schifra::reed_solomon::erasure_locations_t missing_row_index;
+
+      const std::size_t missing_count = 1 + (iteration % fec_length);
+
+      for (std::size_t i = 0; i < missing_count; ++i)
+      {
+         const std::size_t missing_index = (iteration + (i * 3)) % row_count;
+
+         bool duplicate = false;
+
+         for (std::size_t j = 0; j < missing_row_index.size(); ++j)
+         {
+            duplicate |= (missing_row_index[j] == missing_index);
+         }
+
+         if (duplicate)
+            continue;
+
+         block_stack[missing_index].clear();
+         missing_row_index.push_back(missing_index);
+      }
+
+      if (!codec.decode(missing_row_index,&block_stack[0],workspace))
+      {
+         std::cout << "Error - Failed to decode stack! rows: " << row_count << std::endl;
+         return false;
+      }
+
+      for (std::size_t i = 0; i < data_size; ++i)
+      {
+         if (block_stack[i / code_length][i % code_length] != send_data[i])
+         {
+            std::cout << "Error - Final block stack comparison failed! rows: " << row_count
+                      << " symbol: " << i << std::endl;
+            return false;
+         }
+      }
+   }
+
+   timer.stop();
+
+   double mbps = (max_iterations * data_size * 8.0) / (1048576.0 * timer.time());
+
+   printf("Rows: %3lu Data Rows: %3lu Max Erasures: %3lu Rate: %8.3fMbps\n",
+          static_cast<unsigned long>(row_count),
+          static_cast<unsigned long>(codec.data_row_count()),
+          static_cast<unsigned long>(fec_length),
+          mbps);
+
+   return true;
+}
+
+int main()
+{
+   /* Reed Solomon Code Parameters */
+   const std::size_t code_length = 255;
+   const std::size_t fec_length  =   8;
+
+   /* Finite Field Parameters */
+   const std::size_t field_descriptor                =   8;
+   const std::size_t generator_polynomial_index      = 120;
+   const std::size_t generator_polynomial_root_count = fec_length;
+
+   /* Instantiate Finite Field and Generator Polynomials */
+   const schifra::galois::field field(field_descriptor,
+                                      schifra::galois::primitive_polynomial_size06,
+                                      schifra::galois::primitive_polynomial06);
+
+   schifra::galois::field_polynomial generator_polynomial(field);
+
+   if (
+        !schifra::make_sequential_root_generator_polynomial(field,
+                                                            generator_polynomial_index,
+                                                            generator_polynomial_root_count,
+                                                            generator_polynomial)
+      )
+   {
+      std::cout << "Error - Failed to create sequential root generator!" << std::endl;
+      return 1;
+   }
+
+   const std::size_t window_list[] = { 16, 32, 64, code_length };
+
+   for (std::size_t i = 0; i < (sizeof(window_list) / sizeof(std::size_t)); ++i)
+   {
+      if (!erasure_channel_window_test<code_length,fec_length>(field,
+                                                               generator_polynomial,
+                                                               generator_polynomial_index,
+                                                               window_list[i],
+                                                               1000))
+      {
+         return 1;
+      }
+   }
+
+   return 0;
+}
@@ -0,0 +1,207 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+/*
+   Description: This example will demonstrate a streaming erasure channel
+                receiver, which reports each missing packet to the erasure
+                state as soon as a gap in the sequence numbers reveals it.
+                Once the window closes, the missing packets are recovered by
+                a single multiply-accumulate pass. The time taken from the
+                window closing to the recovery of its packets is compared to
+                that of computing the whole erasure state at window close.
+*/
+
+
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "schifra_galois_field.hpp"
+#include "schifra_galois_field_polynomial.hpp"
+#include "schifra_sequential_root_generator_polynomial_creator.hpp"
+#include "schifra_reed_solomon_block.hpp"
+#include "schifra_reed_solomon_encoder.hpp"
+#include "schifra_erasure_channel.hpp"
+#include "schifra_utilities.hpp"
+
+
+int main()
+{
+   /* Reed Solomon Code Parameters */
+   const std::size_t code_length = 255;
+   const std::size_t fec_length  =  32;
+   const std::size_t data_length = code_length - fec_length;
+   const std::size_t stack_size  = code_length;
+
+   /* Finite Field Parameters */
+   const std::size_t field_descriptor                =   8;
+   const std::size_t generator_polynomial_index      = 120;
+   const std::size_t generator_polynomial_root_count = fec_length;
+
+   /* Instantiate Finite Field and Generator Polynomials */
+   const schifra::galois::field field(field_descriptor,
+                                      schifra::galois::primitive_polynomial_size06,
+                                      schifra::galois::primitive_polynomial06);
+
+   schifra::galois::field_polynomial generator_polynomial(field);
+
+   if (
+        !schifra::make_sequential_root_generator_polynomial(field,
+                                                            generator_polynomial_index,
+                                                            generator_polynomial_root_count,
+                                                            generator_polynomial)
+      )
+   {
+      std::cout << "Error - Failed to create sequential root generator!" << std::endl;
+      return 1;
+   }
+
+   /* Instantiate Encoder and Decoder (Codec) */
+   typedef schifra::reed_solomon::encoder<code_length,fec_length> encoder_t;
+   typedef schifra::reed_solomon::erasure_code_decoder<code_length,fec_length> decoder_t;
+   typedef schifra::reed_solomon::block<code_length,fec_length,data_length,unsigned char> packet_t;
+
+   const encoder_t rs_encoder(field,generator_polynomial);
+   const decoder_t rs_erasure_decoder(field,generator_polynomial_index);
+
+   static packet_t send_stack[stack_size];
+   static packet_t recv_stack[stack_size];
+
+   decoder_t::workspace stream_workspace;
+   decoder_t::workspace window_workspace;
+
+   const std::size_t max_iterations = 1000;
+
+   double stream_time = 0.0;
+   double window_time = 0.0;
+
+   for (std::size_t iteration = 0; iteration < max_iterations; ++iteration)
+   {
+      /* Populate the codewords (the rows) with data, encode and interleave them into packets */
+      for (std::size_t i = 0; i < stack_size; ++i)
+      {
+         for (std::size_t j = 0; j < data_length; ++j)
+         {
+            send_stack[i][j] = static_cast<unsigned char>((i * 3 + j * 5 + 7 * iteration) & 0xFF);
+         }
+      }
+
+      if (!schifra::reed_solomon::encode_and_interleave(rs_encoder,send_stack))
+      {
+         std::cout << "Error - Failed to encode stack!" << std::endl;
+         return 1;
+      }
+
+      /*
+         Receive the packets in sequence - Simulate network packet loss (e.g: UDP).
+         A packet arriving after a gap reveals the packets missing before it.
+      */
+      const std::size_t missing_count = 1 + (iteration % fec_length);
+
+      schifra::reed_solomon::erasure_locations_t missing_row_index;
+
+      rs_erasure_decoder.clear_erasures(stream_workspace);
+
+      std::size_t next_expected = 0;
+
+      for (std::size_t sequence = 0; sequence < stack_size; ++sequence)
+      {
+         if ((((sequence * 37) + (iteration * 11)) % stack_size) < missing_count)
+         {
+            // Packet never arrives
+            recv_stack[sequence].clear();
+            continue;
+         }
+
+         for (; next_expected < sequence; ++next_expected)
+         {
+            rs_erasure_decoder.add_erasure(next_expected,stream_workspace);
+            missing_row_index.push_back(next_expected);
+         }
+
+         recv_stack[sequence] = send_stack[sequence];
+         next_expected = sequence + 1;
+      }
+
+      std::vector<packet_t> copy_stack(recv_stack, recv_stack + stack_size);
+
+      schifra::utils::timer timer;
+
+      /*
+         Window closes: packets lost at the tail of the window are only now known
+         of, the rest are recovered from the erasure state built up during reception.
+      */
+      timer.start();
+
+      for (; next_expected < stack_size; ++next_expected)
+      {
+         rs_erasure_decoder.add_erasure(next_expected,stream_workspace);
+         missing_row_index.push_back(next_expected);
+      }
+
+      if (!rs_erasure_decoder.decode_stack(recv_stack,stream_workspace))
+      {
+         std::cout << "Error - Failed to decode stack from the erasure stream!" << std::endl;
+         return 1;
+      }
+
+      timer.stop();
+      stream_time += timer.time();
+
+      /* Window closes: compute the erasure state and then recover */
+      timer.start();
+
+      if (!rs_erasure_decoder.decode_stack(&copy_stack[0],missing_row_index,window_workspace))
+      {
+         std::cout << "Error - Failed to decode stack from the erasure list!" << std::endl;
+         return 1;
+      }
+
+      timer.stop();
+      window_time += timer.time();
+
+      for (std::size_t i = 0; i < stack_size; ++i)
+      {
+         for (std::size_t j = 0; j < code_length; ++j)
+         {
+            if (
+                 (recv_stack[i][j] != send_stack[i][j]) ||
+                 (copy_stack[i][j] != send_stack[i][j])
+               )
+            {
+               std::cout << "Error: Final block stack comparison failed! packet: " << i << std::endl;
+               return 1;
+            }
+         }
+      }
+   }
+
+   printf("Windows: %lu Erasures: 1-%lu\tStreamed erasure state: %7.3fus/window\tErasure state at window close: %7.3fus/window\n",
+          static_cast<unsigned long>(max_iterations),
+          static_cast<unsigned long>(fec_length),
+          (1000000.0 * stream_time) / max_iterations,
+          (1000000.0 * window_time) / max_iterations);
+
+   return 0;
+}
@@ -0,0 +1,275 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+#ifndef INCLUDE_SCHIFRA_GALOIS_FIELD_REGION_HPP
+#define INCLUDE_SCHIFRA_GALOIS_FIELD_REGION_HPP
+
+
+#include <cstddef>
+#include <vector>
+
+#include "schifra_cpu_features.hpp"
+#include "schifra_galois_field.hpp"
+
+#if defined(SCHIFRA_X86_DISPATCH)
+   #include <immintrin.h>
+#endif
+
+
+namespace schifra
+{
+
+   namespace galois
+   {
+
+      class region_multiplier
+      {
+      public:
+
+         /*
+           Multiplication of whole regions of symbols by a constant, for
+           fields of up to 2^8 elements whose symbols are held as bytes.
+           Each constant c has a pair of 16 entry tables, being the
+           products of c with the low and the high nibble of a symbol, so
+           that c * x = low[x & 0x0F] ^ high[x >> 4] - which is the form
+           the SSSE3/AVX2 byte shuffles evaluate 16/32 symbols at a time.
+           With GFNI the product is instead a single affine transform by
+           the 8x8 bit matrix of c. The kernels are bound at construction
+           to the given (by default the active) cpu level, the scalar
+           table kernels always being present.
+         */
+
+         explicit region_multiplier(const field& gfield, const cpu::level lvl = cpu::active_level())
+         : valid_(gfield.pwr() <= 8),
+           level_(valid_ ? lvl : cpu::scalar),
+           table_ (valid_ ? (256 * 32) : 0, 0),
+           matrix_(valid_ ?  256       : 0, 0)
+         {
+            if (!valid_)
+               return;
+
+            const int power = static_cast<int>(gfield.pwr());
+
+            for (unsigned int c = 0; c <= gfield.size(); ++c)
+            {
+               // Products of c with each basis element 2^b
+               unsigned char basis[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+               for (int b = 0; b < power; ++b)
+               {
+                  basis[b] = static_cast<unsigned char>(gfield.mul(static_cast<field_symbol>(c), 1 << b));
+               }
+
+               unsigned char* table = &table_[32 * c];
+
+               for (unsigned int x = 0; x < 16; ++x)
+               {
+                  for (int b = 0; b < 4; ++b)
+                  {
+                     if ((x >> b) & 1)
+                     {
+                        table[x     ] ^= basis[b    ];
+                        table[x + 16] ^= basis[b + 4];
+                     }
+                  }
+               }
+
+               /*
+                 Bit i of the product is the parity of x masked by byte
+                 (7 - i) of the matrix.
+               */
+               unsigned long long matrix = 0;
+
+               for (int i = 0; i < 8; ++i)
+               {
+                  unsigned long long row = 0;
+
+                  for (int b = 0; b < 8; ++b)
+                  {
+                     row |= static_cast<unsigned long long>((basis[b] >> i) & 1) << b;
+                  }
+
+                  matrix |= row << (8 * (7 - i));
+               }
+
+               matrix_[c] = matrix;
+            }
+         }
+
+         inline bool valid() const
+         {
+            return valid_;
+         }
+
+         inline cpu::level level() const
+         {
+            return level_;
+         }
+
+         inline const unsigned char* table(const unsigned char c) const
+         {
+            return &table_[32 * c];
+         }
+
+         inline unsigned long long matrix(const unsigned char c) const
+         {
+            return matrix_[c];
+         }
+
+         inline unsigned char mul(const unsigned char c, const unsigned char x) const
+         {
+            const unsigned char* t = table(c);
+            return t[x & 0x0F] ^ t[16 + (x >> 4)];
+         }
+
+         inline void multiply(const unsigned char c, const unsigned char src[], unsigned char dst[], const std::size_t length) const
+         {
+            // dst = c * src
+            region<false>(c, src, dst, length);
+         }
+
+         inline void multiply_add(const unsigned char c, const unsigned char src[], unsigned char dst[], const std::size_t length) const
+         {
+            // dst = dst + c * src
+            region<true>(c, src, dst, length);
+         }
+
+      private:
+
+         template <bool accumulate>
+         inline void region(const unsigned char c, const unsigned char src[], unsigned char dst[], const std::size_t length) const
+         {
+            std::size_t i = 0;
+
+            #if defined(SCHIFRA_X86_DISPATCH)
+            switch (level_)
+            {
+               case cpu::gfni  : i = region_gfni <accumulate>(matrix(c), src, dst, length); break;
+               case cpu::avx2  : i = region_avx2 <accumulate>(table (c), src, dst, length); break;
+               case cpu::ssse3 : i = region_ssse3<accumulate>(table (c), src, dst, length); break;
+               default         : break;
+            }
+            #endif
+
+            const unsigned char* t = table(c);
+
+            for (; i < length; ++i)
+            {
+               const unsigned char product = t[src[i] & 0x0F] ^ t[16 + (src[i] >> 4)];
+               dst[i] = (accumulate ? (dst[i] ^ product) : product);
+            }
+         }
+
+         #if defined(SCHIFRA_X86_DISPATCH)
+
+         /*
+           The vector kernels process whole vectors only, returning the
+           number of symbols processed, the tail being left to the scalar
+           loop.
+         */
+
+         template <bool accumulate>
+         __attribute__((target("ssse3")))
+         static std::size_t region_ssse3(const unsigned char* t, const unsigned char src[], unsigned char dst[], const std::size_t length)
+         {
+            const __m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t     ));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t + 16));
+            const __m128i mask = _mm_set1_epi8(0x0F);
+
+            std::size_t i = 0;
+
+            for (; (i + 16) <= length; i += 16)
+            {
+               const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+               __m128i product = _mm_xor_si128(_mm_shuffle_epi8(low , _mm_and_si128(x, mask)),
+                                               _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi64(x, 4), mask)));
+
+               if (accumulate)
+                  product = _mm_xor_si128(product, _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i)));
+
+               _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), product);
+            }
+
+            return i;
+         }
+
+         template <bool accumulate>
+         __attribute__((target("avx2")))
+         static std::size_t region_avx2(const unsigned char* t, const unsigned char src[], unsigned char dst[], const std::size_t length)
+         {
+            const __m256i low  = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t     )));
+            const __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t + 16)));
+            const __m256i mask = _mm256_set1_epi8(0x0F);
+
+            std::size_t i = 0;
+
+            for (; (i + 32) <= length; i += 32)
+            {
+               const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+
+               __m256i product = _mm256_xor_si256(_mm256_shuffle_epi8(low , _mm256_and_si256(x, mask)),
+                                                  _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi64(x, 4), mask)));
+
+               if (accumulate)
+                  product = _mm256_xor_si256(product, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i)));
+
+               _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), product);
+            }
+
+            return i;
+         }
+
+         template <bool accumulate>
+         __attribute__((target("avx2,gfni")))
+         static std::size_t region_gfni(const unsigned long long m, const unsigned char src[], unsigned char dst[], const std::size_t length)
+         {
+            const __m256i matrix = _mm256_set1_epi64x(static_cast<long long>(m));
+
+            std::size_t i = 0;
+
+            for (; (i + 32) <= length; i += 32)
+            {
+               __m256i product = _mm256_gf2p8affine_epi64_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), matrix, 0);
+
+               if (accumulate)
+                  product = _mm256_xor_si256(product, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i)));
+
+               _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), product);
+            }
+
+            return i;
+         }
+
+         #endif
+
+         bool                            valid_;
+         cpu::level                      level_;
+         std::vector<unsigned char>      table_;
+         std::vector<unsigned long long> matrix_;
+      };
+
+   } // namespace galois
+
+} // namespace schifra
+
+#endif
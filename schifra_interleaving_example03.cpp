@@ -46,8 +46,67 @@ bool block_stacks_equivelent(const schifra::reed_solomon::data_block<std::size_t
    return true;
 }
 
+bool block_partial_interleave_test()
+{
+   /*
+     The partial interleave of a stack of Reed-Solomon blocks is to match
+     that of a stack of data blocks of the same symbols, and to be undone
+     by the partial deinterleave.
+   */
+
+   const std::size_t code_length    = 15;
+   const std::size_t fec_length     =  4;
+   const std::size_t stack_size     =  6;
+   const std::size_t partial_length = 11;
+
+   typedef schifra::reed_solomon::block<code_length,fec_length> block_type;
+
+   block_type rs_block_stack[stack_size];
+   schifra::reed_solomon::data_block<int,code_length> data_block_stack[stack_size];
+
+   for (std::size_t i = 0; i < stack_size; ++i)
+   {
+      for (std::size_t j = 0; j < code_length; ++j)
+      {
+         rs_block_stack  [i][j] = static_cast<int>((i * code_length) + j);
+         data_block_stack[i][j] = static_cast<int>((i * code_length) + j);
+      }
+   }
+
+   schifra::reed_solomon::interleave<code_length,fec_length,stack_size>(rs_block_stack,partial_length);
+   schifra::reed_solomon::interleave<int,code_length>(data_block_stack,stack_size,partial_length);
+
+   for (std::size_t i = 0; i < stack_size; ++i)
+   {
+      for (std::size_t j = 0; j < ((i < (stack_size - 1)) ? code_length : partial_length); ++j)
+      {
+         if (rs_block_stack[i][j] != data_block_stack[i][j])
+            return false;
+      }
+   }
+
+   schifra::reed_solomon::deinterleave<code_length,fec_length,stack_size>(rs_block_stack,partial_length);
+
+   for (std::size_t i = 0; i < stack_size; ++i)
+   {
+      for (std::size_t j = 0; j < ((i < (stack_size - 1)) ? code_length : partial_length); ++j)
+      {
+         if (rs_block_stack[i][j] != static_cast<int>((i * code_length) + j))
+            return false;
+      }
+   }
+
+   return true;
+}
+
 int main()
 {
+   if (!block_partial_interleave_test())
+   {
+      std::cout << "ERROR - Partial interleave of block stack failed!" << std::endl;
+      return 1;
+   }
+
    const std::size_t block_length   =   10;
    const std::size_t stack_size     =  255;
    const std::size_t max_iterations = 1000;
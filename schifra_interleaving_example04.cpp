@@ -0,0 +1,171 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+/*
+   Description: This example demonstrates the out-of-place interleavers,
+                which write the interleaved layout of a stack straight
+                into an output buffer, or into a list of packet buffers,
+                and deinterleave straight out of them - verified against
+                the in-place interleavers.
+*/
+
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "schifra_reed_solomon_interleaving.hpp"
+#include "schifra_reed_solomon_block.hpp"
+#include "schifra_utilities.hpp"
+
+
+template <std::size_t block_length, std::size_t stack_size>
+bool out_of_place_interleave_test()
+{
+   typedef schifra::reed_solomon::data_block<unsigned char,block_length> data_block_t;
+
+   data_block_t source_stack[stack_size];
+   data_block_t interleaved_stack[stack_size];
+   data_block_t deinterleaved_stack[stack_size];
+
+   for (std::size_t i = 0; i < stack_size; ++i)
+   {
+      for (std::size_t j = 0; j < block_length; ++j)
+      {
+         source_stack[i][j] = static_cast<unsigned char>((i * 7 + j * 13) & 0xFF);
+      }
+
+      interleaved_stack[i] = source_stack[i];
+   }
+
+   data_block_t* interleaved_rows = interleaved_stack;
+
+   schifra::reed_solomon::interleave<unsigned char,block_length>(interleaved_rows,stack_size);
+
+   unsigned char  buffer[block_length * stack_size];
+   unsigned char  packet_buffer[stack_size][block_length];
+   unsigned char* packet[stack_size];
+
+   for (std::size_t i = 0; i < stack_size; ++i)
+   {
+      packet[i] = packet_buffer[i];
+   }
+
+   schifra::reed_solomon::interleave_to<unsigned char,block_length>(source_stack,stack_size,buffer);
+   schifra::reed_solomon::interleave_to<unsigned char,block_length>(source_stack,stack_size,packet);
+
+   for (std::size_t i = 0; i < stack_size; ++i)
+   {
+      for (std::size_t j = 0; j < block_length; ++j)
+      {
+         if (
+              (interleaved_stack[i][j] != buffer[i * block_length + j]) ||
+              (interleaved_stack[i][j] != packet[i][j])
+            )
+         {
+            std::cout << "out_of_place_interleave_test() - Error: Interleaved layouts differ at ["
+                      << i << "][" << j << "]" << std::endl;
+            return false;
+         }
+      }
+   }
+
+   for (std::size_t pass = 0; pass < 2; ++pass)
+   {
+      if (0 == pass)
+         schifra::reed_solomon::deinterleave_from<unsigned char,block_length>(buffer,stack_size,deinterleaved_stack);
+      else
+         schifra::reed_solomon::deinterleave_from<unsigned char,block_length>(packet,stack_size,deinterleaved_stack);
+
+      for (std::size_t i = 0; i < stack_size; ++i)
+      {
+         for (std::size_t j = 0; j < block_length; ++j)
+         {
+            if (deinterleaved_stack[i][j] != source_stack[i][j])
+            {
+               std::cout << "out_of_place_interleave_test() - Error: Deinterleaved stack differs at ["
+                         << i << "][" << j << "]" << std::endl;
+               return false;
+            }
+         }
+      }
+   }
+
+   return true;
+}
+
+int main()
+{
+   if (
+        !out_of_place_interleave_test<255,255>() ||
+        !out_of_place_interleave_test<255, 32>() ||
+        !out_of_place_interleave_test< 10,255>() ||
+        !out_of_place_interleave_test< 37, 19>()
+      )
+   {
+      std::cout <<"ERROR!" << std::endl;
+      return 1;
+   }
+
+   const std::size_t block_length   =  255;
+   const std::size_t stack_size     =  255;
+   const std::size_t max_iterations = 1000;
+
+   typedef schifra::reed_solomon::data_block<unsigned char,block_length> data_block_t;
+
+   data_block_t  block_stack[stack_size];
+   unsigned char buffer[block_length * stack_size];
+
+   for (std::size_t i = 0; i < stack_size; ++i)
+   {
+      block_stack[i].clear(static_cast<unsigned char>(i));
+   }
+
+   schifra::utils::timer timer;
+   timer.start();
+
+   for (std::size_t i = 0; i < max_iterations; ++i)
+   {
+      schifra::reed_solomon::interleave_to    <unsigned char,block_length>(block_stack,stack_size,buffer);
+      schifra::reed_solomon::deinterleave_from<unsigned char,block_length>(buffer,stack_size,block_stack);
+   }
+
+   timer.stop();
+
+   for (std::size_t i = 0; i < stack_size; ++i)
+   {
+      for (std::size_t j = 0; j < block_length; ++j)
+      {
+         if (block_stack[i][j] != static_cast<unsigned char>(i))
+         {
+            std::cout <<"ERROR!" << std::endl;
+            return 1;
+         }
+      }
+   }
+
+   double mbps = ((max_iterations * stack_size * block_length) * 8.0) / (1048576.0 * timer.time());
+
+   std::cout << "Out-of-place Interleave Rate: " << mbps << "Mbps" << std::endl;
+
+   return 0;
+}
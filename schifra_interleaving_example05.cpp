@@ -0,0 +1,200 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+/*
+   Description: This example demonstrates convolutional interleaving as used
+                by DVB, RS(204,188) codewords being streamed through a
+                12 branch, 17 cell deep interleaver and deinterleaver pair.
+                A burst of 96 corrupted symbols upon the channel is spread
+                across the codewords such that each is correctable.
+*/
+
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "schifra_galois_field.hpp"
+#include "schifra_galois_field_polynomial.hpp"
+#include "schifra_sequential_root_generator_polynomial_creator.hpp"
+#include "schifra_reed_solomon_encoder.hpp"
+#include "schifra_reed_solomon_decoder.hpp"
+#include "schifra_reed_solomon_block.hpp"
+#include "schifra_reed_solomon_convolutional_interleaver.hpp"
+
+
+int main()
+{
+   /* Finite Field Parameters */
+   const std::size_t field_descriptor                =   8;
+   const std::size_t generator_polynomial_index      =   0;
+   const std::size_t generator_polynomial_root_count =  16;
+
+   /* Reed Solomon Code Parameters */
+   const std::size_t code_length = 204;
+   const std::size_t fec_length  =  16;
+   const std::size_t data_length = code_length - fec_length;
+
+   /* Convolutional Interleaver Parameters */
+   const std::size_t branch_count = 12;
+   const std::size_t cell_depth   = 17;
+
+   const std::size_t packet_count = 100;
+   const std::size_t burst_start  = 30 * code_length + 77;
+   const std::size_t burst_length = 96;
+
+   /* Instantiate Finite Field and Generator Polynomials */
+   const schifra::galois::field field(field_descriptor,
+                                      schifra::galois::primitive_polynomial_size06,
+                                      schifra::galois::primitive_polynomial06);
+
+   schifra::galois::field_polynomial generator_polynomial(field);
+
+   if (
+        !schifra::make_sequential_root_generator_polynomial(field,
+                                                            generator_polynomial_index,
+                                                            generator_polynomial_root_count,
+                                                            generator_polynomial)
+      )
+   {
+      std::cout << "Error - Failed to create sequential root generator!" << std::endl;
+      return 1;
+   }
+
+   typedef schifra::reed_solomon::shortened_encoder<code_length,fec_length,data_length> encoder_t;
+   typedef schifra::reed_solomon::shortened_decoder<code_length,fec_length,data_length> decoder_t;
+   typedef schifra::reed_solomon::data_block<unsigned char,code_length> packet_t;
+
+   const encoder_t encoder(field,generator_polynomial);
+   const decoder_t decoder(field,generator_polynomial_index);
+
+   schifra::reed_solomon::convolutional_interleaver  <unsigned char> interleaver  (branch_count,cell_depth);
+   schifra::reed_solomon::convolutional_deinterleaver<unsigned char> deinterleaver(branch_count,cell_depth);
+
+   if (!interleaver.valid() || !deinterleaver.valid())
+   {
+      std::cout << "Error - Invalid convolutional interleaver parameters!" << std::endl;
+      return 1;
+   }
+
+   /*
+      The end to end delay, 12 x 11 x 17 = 2244 symbols, is exactly 11
+      packets, hence packet i emerges from the deinterleaver as packet
+      i + 11.
+   */
+   const std::size_t delay_packets = interleaver.delay() / code_length;
+
+   std::vector<std::string> message_list(packet_count);
+
+   std::size_t channel_index     = 0;
+   std::size_t packets_corrected = 0;
+   std::size_t max_corrections   = 0;
+
+   for (std::size_t i = 0; i < (packet_count + delay_packets); ++i)
+   {
+      packet_t packet;
+
+      packet.clear();
+
+      if (i < packet_count)
+      {
+         message_list[i].resize(data_length);
+
+         for (std::size_t j = 0; j < data_length; ++j)
+         {
+            message_list[i][j] = static_cast<char>((i * 31 + j * 7) & 0xFF);
+         }
+
+         schifra::reed_solomon::block<code_length,fec_length> block;
+
+         if (!encoder.encode(message_list[i], block))
+         {
+            std::cout << "Error - Critical encoding failure! "
+                      << "Msg: " << block.error_as_string()  << std::endl;
+            return 1;
+         }
+
+         for (std::size_t j = 0; j < code_length; ++j)
+         {
+            packet[j] = static_cast<unsigned char>(block[j]);
+         }
+      }
+
+      interleaver.process(packet);
+
+      /* The channel: a burst of corrupted symbols */
+      for (std::size_t j = 0; j < code_length; ++j, ++channel_index)
+      {
+         if ((channel_index >= burst_start) && (channel_index < (burst_start + burst_length)))
+         {
+            packet[j] ^= 0xFF;
+         }
+      }
+
+      deinterleaver.process(packet);
+
+      if (i < delay_packets)
+         continue;
+
+      const std::size_t packet_index = i - delay_packets;
+
+      schifra::reed_solomon::block<code_length,fec_length> block;
+
+      for (std::size_t j = 0; j < code_length; ++j)
+      {
+         block[j] = packet[j];
+      }
+
+      if (!decoder.decode(block))
+      {
+         std::cout << "Error - Critical decoding failure! Packet: " << packet_index << " "
+                   << "Msg: " << block.error_as_string()  << std::endl;
+         return 1;
+      }
+
+      for (std::size_t j = 0; j < data_length; ++j)
+      {
+         if (static_cast<unsigned char>(message_list[packet_index][j]) != block[j])
+         {
+            std::cout << "Error - Error correction failed! Packet: " << packet_index << std::endl;
+            return 1;
+         }
+      }
+
+      if (block.errors_corrected > 0)
+      {
+         ++packets_corrected;
+
+         if (block.errors_corrected > max_corrections)
+            max_corrections = block.errors_corrected;
+      }
+   }
+
+   std::cout << "Interleaver memory: "          << interleaver.memory()   << " symbols" << std::endl;
+   std::cout << "End to end delay: "            << interleaver.delay()    << " symbols" << std::endl;
+   std::cout << "Burst length: "                << burst_length           << " symbols" << std::endl;
+   std::cout << "Packets corrected: "           << packets_corrected      << std::endl;
+   std::cout << "Max corrections per packet: "  << max_corrections        << std::endl;
+
+   return 0;
+}
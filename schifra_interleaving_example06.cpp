@@ -0,0 +1,225 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+/*
+   Description: This example demonstrates algebraic interleaving, where the
+                codewords are encoded and decoded directly at their
+                interleaved positions within the transmitted buffer by way of
+                permuted block views - there being no stack of codewords to
+                interleave or deinterleave. A burst far longer than the fec
+                length of any one codeword is corrected.
+*/
+
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "schifra_galois_field.hpp"
+#include "schifra_galois_field_polynomial.hpp"
+#include "schifra_sequential_root_generator_polynomial_creator.hpp"
+#include "schifra_reed_solomon_encoder.hpp"
+#include "schifra_reed_solomon_decoder.hpp"
+#include "schifra_reed_solomon_block.hpp"
+#include "schifra_reed_solomon_interleaving.hpp"
+
+
+template <typename Permutation,
+          typename Encoder,
+          typename Decoder,
+          std::size_t code_length,
+          std::size_t fec_length>
+bool algebraic_interleaver_test(const Permutation& permutation,
+                                const Encoder&     encoder,
+                                const Decoder&     decoder,
+                                const std::size_t  codeword_count,
+                                const std::size_t  burst_length,
+                                const std::string& name)
+{
+   typedef schifra::reed_solomon::permuted_block_view<code_length,fec_length,Permutation> view_t;
+
+   const std::size_t data_length = code_length - fec_length;
+
+   if (!permutation.valid() || (permutation.size() != (codeword_count * code_length)))
+   {
+      std::cout << name << " - Error: Invalid permutation!" << std::endl;
+      return false;
+   }
+
+   std::vector<unsigned char> buffer(permutation.size());
+
+   /* Place the data and encode each codeword at its interleaved positions */
+   for (std::size_t c = 0; c < codeword_count; ++c)
+   {
+      view_t codeword(&buffer[0], permutation, c);
+
+      for (std::size_t i = 0; i < data_length; ++i)
+      {
+         codeword[i] = static_cast<unsigned char>((c * 17 + i * 5) & 0xFF);
+      }
+
+      if (!encoder.encode(codeword))
+      {
+         std::cout << name << " - Error: Critical encoding failure! "
+                   << "Msg: " << codeword.error_as_string()  << std::endl;
+         return false;
+      }
+   }
+
+   /* The channel: a burst of corrupted symbols */
+   for (std::size_t i = 0; i < burst_length; ++i)
+   {
+      buffer[(buffer.size() / 3) + i] ^= 0x5A;
+   }
+
+   std::size_t total_corrected = 0;
+
+   for (std::size_t c = 0; c < codeword_count; ++c)
+   {
+      view_t codeword(&buffer[0], permutation, c);
+
+      if (!decoder.decode(codeword))
+      {
+         std::cout << name << " - Error: Critical decoding failure! Codeword: " << c << " "
+                   << "Msg: " << codeword.error_as_string()  << std::endl;
+         return false;
+      }
+
+      for (std::size_t i = 0; i < data_length; ++i)
+      {
+         if (codeword[i] != static_cast<unsigned char>((c * 17 + i * 5) & 0xFF))
+         {
+            std::cout << name << " - Error: Error correction failed! Codeword: " << c << std::endl;
+            return false;
+         }
+      }
+
+      total_corrected += codeword.errors_corrected;
+   }
+
+   std::cout << name << " - Codewords: " << codeword_count
+             << " Burst: "               << burst_length
+             << " Corrected: "           << total_corrected << std::endl;
+
+   return (total_corrected == burst_length);
+}
+
+int main()
+{
+   /* Finite Field Parameters */
+   const std::size_t field_descriptor                =   8;
+   const std::size_t generator_polynomial_index      = 120;
+   const std::size_t generator_polynomial_root_count =  32;
+
+   /* Reed Solomon Code Parameters */
+   const std::size_t code_length = 255;
+   const std::size_t fec_length  =  32;
+
+   const std::size_t codeword_count = 1024;
+
+   /* Instantiate Finite Field and Generator Polynomials */
+   const schifra::galois::field field(field_descriptor,
+                                      schifra::galois::primitive_polynomial_size06,
+                                      schifra::galois::primitive_polynomial06);
+
+   schifra::galois::field_polynomial generator_polynomial(field);
+
+   if (
+        !schifra::make_sequential_root_generator_polynomial(field,
+                                                            generator_polynomial_index,
+                                                            generator_polynomial_root_count,
+                                                            generator_polynomial)
+      )
+   {
+      std::cout << "Error - Failed to create sequential root generator!" << std::endl;
+      return 1;
+   }
+
+   typedef schifra::reed_solomon::encoder<code_length,fec_length> encoder_t;
+   typedef schifra::reed_solomon::decoder<code_length,fec_length> decoder_t;
+
+   const encoder_t encoder(field,generator_polynomial);
+   const decoder_t decoder(field,generator_polynomial_index);
+
+   const schifra::reed_solomon::block_permutation  block_permutation (codeword_count,code_length);
+   const schifra::reed_solomon::linear_permutation linear_permutation(codeword_count * code_length);
+
+   /*
+      Each codeword can correct 16 errors, hence the block interleaver
+      corrects bursts of up to 16 x 1024 symbols. The linear interleaver
+      spreads a burst near evenly, rather than exactly so.
+   */
+   if (
+        !algebraic_interleaver_test<schifra::reed_solomon::block_permutation,encoder_t,decoder_t,code_length,fec_length>
+           (block_permutation, encoder, decoder, codeword_count, 16 * codeword_count, "Block Permutation")   ||
+        !algebraic_interleaver_test<schifra::reed_solomon::linear_permutation,encoder_t,decoder_t,code_length,fec_length>
+           (linear_permutation, encoder, decoder, codeword_count, 12 * codeword_count, "Linear Permutation")
+      )
+   {
+      return 1;
+   }
+
+   /* The block permutation places symbols as interleave_to does */
+   std::vector<unsigned char> source     (block_permutation.size());
+   std::vector<unsigned char> physical   (block_permutation.size());
+   std::vector<unsigned char> interleaved(block_permutation.size());
+   std::vector<unsigned char> restored   (block_permutation.size());
+
+   for (std::size_t i = 0; i < source.size(); ++i)
+   {
+      source[i] = static_cast<unsigned char>((i * 131) & 0xFF);
+   }
+
+   schifra::reed_solomon::interleave_to(&source[0], codeword_count, code_length, &physical[0]);
+   schifra::reed_solomon::interleave_to(block_permutation, &source[0], &interleaved[0]);
+
+   if (physical != interleaved)
+   {
+      std::cout << "Error - Block permutation and interleave_to layouts differ!" << std::endl;
+      return 1;
+   }
+
+   /* Each permutation's inverse restores the original order */
+   schifra::reed_solomon::interleave_to    (linear_permutation, &source     [0], &interleaved[0]);
+   schifra::reed_solomon::deinterleave_from(linear_permutation, &interleaved[0], &restored   [0]);
+
+   if (source != restored)
+   {
+      std::cout << "Error - Linear permutation round trip failed!" << std::endl;
+      return 1;
+   }
+
+   for (std::size_t i = 0; i < source.size(); ++i)
+   {
+      if (
+           (i != linear_permutation.inverse(linear_permutation(i))) ||
+           (i != block_permutation .inverse(block_permutation (i)))
+         )
+      {
+         std::cout << "Error - Inverse permutation failed at: " << i << std::endl;
+         return 1;
+      }
+   }
+
+   return 0;
+}
@@ -37,15 +37,14 @@ namespace schifra
    namespace reed_solomon
    {
 
-      template <std::size_t code_length, std::size_t fec_length, std::size_t data_length = code_length - fec_length>
-      struct block
+      struct block_state
       {
       public:
 
-         typedef galois::field_symbol symbol_type;
-         typedef traits::reed_solomon_triat<code_length,fec_length,data_length> trait;
-         typedef traits::symbol<code_length> symbol;
-         typedef block<code_length,fec_length,data_length> block_t;
+         /*
+           The decoding state of a block, common to the blocks that own
+           their symbols and to the views over caller owned symbols.
+         */
 
          enum error_t
          {
@@ -59,52 +58,111 @@ namespace schifra
             e_decoder_error4 = 7
          };
 
-         block()
+         block_state()
          : errors_detected (0),
            errors_corrected(0),
            zero_numerators (0),
            unrecoverable(false),
            error(e_no_error)
+         {}
+
+         void reset_state()
+         {
+            errors_detected  = 0;
+            errors_corrected = 0;
+            zero_numerators  = 0;
+            unrecoverable    = false;
+            error            = e_no_error;
+         }
+
+         template <typename BlockType>
+         void copy_state(const BlockType& b)
+         {
+            errors_detected  = b.errors_detected;
+            errors_corrected = b.errors_corrected;
+            zero_numerators  = b.zero_numerators;
+            unrecoverable    = b.unrecoverable;
+            error            = static_cast<error_t>(b.error);
+         }
+
+         inline std::string error_as_string() const
+         {
+            switch (error)
+            {
+               case e_no_error       : return "No Error";
+               case e_encoder_error0 : return "Invalid Encoder";
+               case e_encoder_error1 : return "Incompatible Generator Polynomial";
+               case e_decoder_error0 : return "Invalid Decoder";
+               case e_decoder_error1 : return "Decoder Failure - Non-zero Syndrome";
+               case e_decoder_error2 : return "Decoder Failure - Too Many Errors/Erasures";
+               case e_decoder_error3 : return "Decoder Failure - Invalid Symbol Correction";
+               case e_decoder_error4 : return "Decoder Failure - Invalid Codeword Correction";
+               default               : return "Invalid Error Code";
+            }
+         }
+
+         std::size_t  errors_detected;
+         std::size_t errors_corrected;
+         std::size_t  zero_numerators;
+         bool           unrecoverable;
+         error_t                error;
+      };
+
+      template <std::size_t code_length,
+                std::size_t fec_length,
+                std::size_t data_length = code_length - fec_length,
+                typename    T           = galois::field_symbol>
+      struct block : public block_state
+      {
+      public:
+
+         /*
+           The symbols are stored as T, which may be narrower than the
+           field symbol (eg: unsigned char for GF(2^8) or unsigned short
+           for GF(2^16)) so as to match the layout of the data at hand.
+         */
+
+         typedef T symbol_type;
+         typedef traits::reed_solomon_triat<code_length,fec_length,data_length> trait;
+         typedef traits::symbol<code_length> symbol;
+         typedef block<code_length,fec_length,data_length,T> block_t;
+
+         block()
          {
             traits::validate_reed_solomon_block_parameters<code_length,fec_length,data_length>();
          }
 
          block(const std::string& _data, const std::string& _fec)
-         : errors_detected (0),
-           errors_corrected(0),
-           zero_numerators (0),
-           unrecoverable(false),
-           error(e_no_error)
          {
             traits::validate_reed_solomon_block_parameters<code_length,fec_length,data_length>();
 
             for (std::size_t i = 0; i < data_length; ++i)
             {
-               data[i] = static_cast<galois::field_symbol>(_data[i]);
+               data[i] = static_cast<symbol_type>(_data[i]);
             }
 
             for (std::size_t i = 0; i < fec_length; ++i)
             {
-               data[i + data_length] = static_cast<galois::field_symbol>(_fec[i]);
+               data[i + data_length] = static_cast<symbol_type>(_fec[i]);
             }
          }
 
-         galois::field_symbol& operator[](const std::size_t& index)
+         symbol_type& operator[](const std::size_t& index)
          {
             return data[index];
          }
 
-         const galois::field_symbol& operator[](const std::size_t& index) const
+         const symbol_type& operator[](const std::size_t& index) const
          {
             return data[index];
          }
 
-         galois::field_symbol& operator()(const std::size_t& index)
+         symbol_type& operator()(const std::size_t& index)
          {
             return operator[](index);
          }
 
-         galois::field_symbol& fec(const std::size_t& index)
+         symbol_type& fec(const std::size_t& index)
          {
             return data[data_length + index];
          }
@@ -146,7 +204,7 @@ namespace schifra
             return fec_str;
          }
 
-         void clear(galois::field_symbol value = 0)
+         void clear(symbol_type value = 0)
          {
             for (std::size_t i = 0; i < code_length; ++i)
             {
@@ -154,7 +212,7 @@ namespace schifra
             }
          }
 
-         void clear_data(galois::field_symbol value = 0)
+         void clear_data(symbol_type value = 0)
          {
             for (std::size_t i = 0; i < data_length; ++i)
             {
@@ -162,7 +220,7 @@ namespace schifra
             }
          }
 
-         void clear_fec(galois::field_symbol value = 0)
+         void clear_fec(symbol_type value = 0)
          {
             for (std::size_t i = 0; i < fec_length; ++i)
             {
@@ -170,52 +228,334 @@ namespace schifra
             }
          }
 
-         void reset(galois::field_symbol value = 0)
+         void reset(symbol_type value = 0)
          {
             clear(value);
-            errors_detected  = 0;
-            errors_corrected = 0;
-            zero_numerators  = 0;
-            unrecoverable    = false;
-            error            = e_no_error;
+            reset_state();
          }
 
-         template <typename BlockType>
-         void copy_state(const BlockType& b)
+         symbol_type data[code_length];
+      };
+
+      template <std::size_t code_length, std::size_t fec_length, typename T = unsigned char>
+      class block_view : public block_state
+      {
+      public:
+
+         /*
+           A block over caller owned memory: the data symbols and the fec
+           symbols each being contiguous, though not necessarily adjacent
+           to each other (eg: a packet's payload and its trailer). Nothing
+           is copied, the encoder writes the fec symbols and the decoder
+           corrects the symbols in place.
+         */
+
+         typedef T symbol_type;
+         typedef traits::reed_solomon_triat<code_length,fec_length,code_length - fec_length> trait;
+
+         enum { data_length = code_length - fec_length };
+
+         explicit block_view(symbol_type* codeword)
+         : data_(codeword),
+           fec_ (codeword + data_length)
          {
-            errors_detected  = b.errors_detected;
-            errors_corrected = b.errors_corrected;
-            zero_numerators  = b.zero_numerators;
-            unrecoverable    = b.unrecoverable;
-            error            = static_cast<error_t>(b.error);
+            traits::validate_reed_solomon_block_parameters<code_length,fec_length,code_length - fec_length>();
          }
 
-         inline std::string error_as_string() const
+         block_view(symbol_type* data, symbol_type* fec)
+         : data_(data),
+           fec_ (fec )
          {
-            switch (error)
+            traits::validate_reed_solomon_block_parameters<code_length,fec_length,code_length - fec_length>();
+         }
+
+         inline symbol_type& operator[](const std::size_t& index)
+         {
+            return (index < static_cast<std::size_t>(data_length)) ? data_[index] : fec_[index - data_length];
+         }
+
+         inline const symbol_type& operator[](const std::size_t& index) const
+         {
+            return (index < static_cast<std::size_t>(data_length)) ? data_[index] : fec_[index - data_length];
+         }
+
+         inline symbol_type& fec(const std::size_t& index)
+         {
+            return fec_[index];
+         }
+
+         inline symbol_type* data_begin() const
+         {
+            return data_;
+         }
+
+         inline symbol_type* fec_begin() const
+         {
+            return fec_;
+         }
+
+      private:
+
+         symbol_type* data_;
+         symbol_type* fec_;
+      };
+
+      template <typename T = unsigned char>
+      struct segment
+      {
+         /*
+           A run of contiguous symbols, in the manner of an iovec.
+         */
+
+         segment()
+         : data(0),
+           length(0)
+         {}
+
+         segment(T* _data, const std::size_t _length)
+         : data(_data),
+           length(_length)
+         {}
+
+         T*          data;
+         std::size_t length;
+      };
+
+      template <std::size_t code_length, std::size_t fec_length, typename T = unsigned char>
+      class segmented_block_view : public block_state
+      {
+      public:
+
+         /*
+           A block whose data symbols are scattered over a list of segments
+           (eg: the fragments of a packet's payload) and whose fec symbols
+           are contiguous, encoded and decoded without coalescing the data.
+           Note: The lengths of the segments must total data_length, and
+                 the segment list must outlive the view.
+         */
+
+         typedef T symbol_type;
+         typedef traits::reed_solomon_triat<code_length,fec_length,code_length - fec_length> trait;
+
+         enum { data_length = code_length - fec_length };
+
+         segmented_block_view(const segment<T> segment_list[], const std::size_t segment_count, symbol_type* fec)
+         : segment_list_  (segment_list ),
+           segment_count_ (segment_count),
+           fec_           (fec          ),
+           segment_index_ (0),
+           segment_offset_(0)
+         {
+            traits::validate_reed_solomon_block_parameters<code_length,fec_length,code_length - fec_length>();
+         }
+
+         inline symbol_type& operator[](const std::size_t& index)
+         {
+            return (index < static_cast<std::size_t>(data_length)) ? data_symbol(index) : fec_[index - data_length];
+         }
+
+         inline const symbol_type& operator[](const std::size_t& index) const
+         {
+            return (index < static_cast<std::size_t>(data_length)) ? data_symbol(index) : fec_[index - data_length];
+         }
+
+         inline symbol_type& fec(const std::size_t& index)
+         {
+            return fec_[index];
+         }
+
+         inline std::size_t segment_count() const
+         {
+            return segment_count_;
+         }
+
+      private:
+
+         inline symbol_type& data_symbol(const std::size_t index) const
+         {
+            /*
+              The segments are walked on from the last one visited, as the
+              codec visits the symbols mostly in order.
+            */
+
+            if (index < segment_offset_)
             {
-               case e_no_error       : return "No Error";
-               case e_encoder_error0 : return "Invalid Encoder";
-               case e_encoder_error1 : return "Incompatible Generator Polynomial";
-               case e_decoder_error0 : return "Invalid Decoder";
-               case e_decoder_error1 : return "Decoder Failure - Non-zero Syndrome";
-               case e_decoder_error2 : return "Decoder Failure - Too Many Errors/Erasures";
-               case e_decoder_error3 : return "Decoder Failure - Invalid Symbol Correction";
-               case e_decoder_error4 : return "Decoder Failure - Invalid Codeword Correction";
-               default               : return "Invalid Error Code";
+               segment_index_  = 0;
+               segment_offset_ = 0;
             }
+
+            while (index >= (segment_offset_ + segment_list_[segment_index_].length))
+            {
+               segment_offset_ += segment_list_[segment_index_].length;
+               ++segment_index_;
+            }
+
+            return segment_list_[segment_index_].data[index - segment_offset_];
          }
 
-         std::size_t  errors_detected;
-         std::size_t errors_corrected;
-         std::size_t  zero_numerators;
-         bool           unrecoverable;
-         error_t                error;
-         galois::field_symbol data[code_length];
+         const segment<T>*   segment_list_;
+         std::size_t         segment_count_;
+         symbol_type*        fec_;
+         mutable std::size_t segment_index_;
+         mutable std::size_t segment_offset_;
       };
 
-      template <std::size_t code_length, std::size_t fec_length>
-      inline void copy(const block<code_length,fec_length>& src_block, block<code_length,fec_length>& dest_block)
+      template <std::size_t code_length, std::size_t fec_length, typename T = galois::field_symbol>
+      class strided_block_view : public block_state
+      {
+      public:
+
+         /*
+           A block over caller owned symbols that are evenly spaced, stride
+           symbols apart within the one array - eg: a column of a matrix of
+           symbols. (The columns of a stack of blocks are viewed by way of
+           block_column_view, as the rows are distinct objects.)
+         */
+
+         typedef T symbol_type;
+         typedef traits::reed_solomon_triat<code_length,fec_length,code_length - fec_length> trait;
+
+         enum { data_length = code_length - fec_length };
+
+         strided_block_view(symbol_type* base, const std::size_t stride)
+         : base_  (base  ),
+           stride_(stride)
+         {
+            traits::validate_reed_solomon_block_parameters<code_length,fec_length,code_length - fec_length>();
+         }
+
+         inline symbol_type& operator[](const std::size_t& index)
+         {
+            return base_[index * stride_];
+         }
+
+         inline const symbol_type& operator[](const std::size_t& index) const
+         {
+            return base_[index * stride_];
+         }
+
+         inline symbol_type& fec(const std::size_t& index)
+         {
+            return base_[(data_length + index) * stride_];
+         }
+
+         inline std::size_t stride() const
+         {
+            return stride_;
+         }
+
+      private:
+
+         symbol_type* base_;
+         std::size_t  stride_;
+      };
+
+      template <std::size_t code_length, std::size_t fec_length, typename Permutation, typename T = unsigned char>
+      class permuted_block_view : public block_state
+      {
+      public:
+
+         /*
+           The codeword'th codeword of a buffer of codewords whose symbols
+           have been placed by an index permutation (eg: an algebraic
+           interleaver), symbol i being found at position
+           permutation(codeword * code_length + i) of the buffer. Codewords
+           are thereby encoded and decoded at their interleaved positions,
+           without a stack to interleave from or deinterleave into.
+           Note: The permutation must outlive the view.
+         */
+
+         typedef T symbol_type;
+         typedef traits::reed_solomon_triat<code_length,fec_length,code_length - fec_length> trait;
+
+         enum { data_length = code_length - fec_length };
+
+         permuted_block_view(symbol_type* buffer, const Permutation& permutation, const std::size_t codeword)
+         : buffer_     (buffer                  ),
+           permutation_(permutation             ),
+           base_       (codeword * code_length  )
+         {
+            traits::validate_reed_solomon_block_parameters<code_length,fec_length,code_length - fec_length>();
+         }
+
+         inline symbol_type& operator[](const std::size_t& index)
+         {
+            return buffer_[permutation_(base_ + index)];
+         }
+
+         inline const symbol_type& operator[](const std::size_t& index) const
+         {
+            return buffer_[permutation_(base_ + index)];
+         }
+
+         inline symbol_type& fec(const std::size_t& index)
+         {
+            return buffer_[permutation_(base_ + data_length + index)];
+         }
+
+      private:
+
+         symbol_type*       buffer_;
+         const Permutation& permutation_;
+         std::size_t        base_;
+      };
+
+      template <std::size_t code_length, std::size_t fec_length, typename T = galois::field_symbol>
+      class block_column_view : public block_state
+      {
+      public:
+
+         /*
+           The column'th symbols of a stack of blocks, symbol i being that
+           of row i - eg: a column code of a product code, or a codeword of
+           an erasure channel stack. The column codes are thereby encoded
+           and decoded in place, with neither a transpose nor a copy.
+         */
+
+         typedef T symbol_type;
+         typedef block<code_length,fec_length,code_length - fec_length,T> row_type;
+         typedef traits::reed_solomon_triat<code_length,fec_length,code_length - fec_length> trait;
+
+         enum { data_length = code_length - fec_length };
+
+         block_column_view(row_type* block_stack, const std::size_t column)
+         : block_stack_(block_stack),
+           column_     (column     )
+         {
+            traits::validate_reed_solomon_block_parameters<code_length,fec_length,code_length - fec_length>();
+         }
+
+         inline symbol_type& operator[](const std::size_t& index)
+         {
+            return block_stack_[index].data[column_];
+         }
+
+         inline const symbol_type& operator[](const std::size_t& index) const
+         {
+            return block_stack_[index].data[column_];
+         }
+
+         inline symbol_type& fec(const std::size_t& index)
+         {
+            return block_stack_[data_length + index].data[column_];
+         }
+
+      private:
+
+         row_type*   block_stack_;
+         std::size_t column_;
+      };
+
+      template <std::size_t code_length, std::size_t fec_length, typename T>
+      inline block_column_view<code_length,fec_length,T> column_view(block<code_length,fec_length,code_length - fec_length,T> (&block_stack)[code_length],
+                                                                     const std::size_t column)
+      {
+         // The column'th codeword of a square stack of blocks (eg: of a product code or an erasure channel)
+         return block_column_view<code_length,fec_length,T>(block_stack, column);
+      }
+
+      template <std::size_t code_length, std::size_t fec_length, std::size_t data_length, typename S>
+      inline void copy(const block<code_length,fec_length,data_length,S>& src_block, block<code_length,fec_length,data_length,S>& dest_block)
       {
          for (std::size_t index = 0; index < code_length; ++index)
          {
@@ -223,29 +563,29 @@ namespace schifra
          }
       }
 
-      template <typename T, std::size_t code_length, std::size_t fec_length>
-      inline void copy(const T src_data[], block<code_length,fec_length>& dest_block)
+      template <typename T, std::size_t code_length, std::size_t fec_length, std::size_t data_length, typename S>
+      inline void copy(const T src_data[], block<code_length,fec_length,data_length,S>& dest_block)
       {
-         for (std::size_t index = 0; index < (code_length - fec_length); ++index, ++src_data)
+         for (std::size_t index = 0; index < data_length; ++index, ++src_data)
          {
-            dest_block.data[index] = static_cast<typename block<code_length,fec_length>::symbol_type>(*src_data);
+            dest_block.data[index] = static_cast<S>(*src_data);
          }
       }
 
-      template <typename T, std::size_t code_length, std::size_t fec_length>
+      template <typename T, std::size_t code_length, std::size_t fec_length, std::size_t data_length, typename S>
       inline void copy(const T src_data[],
                        const std::size_t& src_length,
-                       block<code_length,fec_length>& dest_block)
+                       block<code_length,fec_length,data_length,S>& dest_block)
       {
          for (std::size_t index = 0; index < src_length; ++index, ++src_data)
          {
-            dest_block.data[index] = static_cast<typename block<code_length,fec_length>::symbol_type>(*src_data);
+            dest_block.data[index] = static_cast<S>(*src_data);
          }
       }
 
-      template <std::size_t code_length, std::size_t fec_length, std::size_t stack_size>
-      inline void copy(const block<code_length,fec_length>  src_block_stack[stack_size],
-                             block<code_length,fec_length> dest_block_stack[stack_size])
+      template <std::size_t code_length, std::size_t fec_length, std::size_t stack_size, std::size_t data_length, typename S>
+      inline void copy(const block<code_length,fec_length,data_length,S>  src_block_stack[stack_size],
+                             block<code_length,fec_length,data_length,S> dest_block_stack[stack_size])
       {
          for (std::size_t row = 0; row < stack_size; ++row)
          {
@@ -253,13 +593,11 @@ namespace schifra
          }
       }
 
-      template <typename T, std::size_t code_length, std::size_t fec_length, std::size_t stack_size>
+      template <typename T, std::size_t code_length, std::size_t fec_length, std::size_t stack_size, std::size_t data_length, typename S>
       inline bool copy(const T src_data[],
                        const std::size_t src_length,
-                       block<code_length,fec_length> dest_block_stack[stack_size])
+                       block<code_length,fec_length,data_length,S> dest_block_stack[stack_size])
       {
-         const std::size_t data_length = code_length - fec_length;
-
          if (src_length > (stack_size * data_length))
          {
             return false;
@@ -280,8 +618,8 @@ namespace schifra
          return true;
       }
 
-      template <typename T, std::size_t code_length, std::size_t fec_length>
-      inline void full_copy(const block<code_length,fec_length>& src_block,
+      template <typename T, std::size_t code_length, std::size_t fec_length, std::size_t data_length, typename S>
+      inline void full_copy(const block<code_length,fec_length,data_length,S>& src_block,
                             T dest_data[])
       {
          for (std::size_t i = 0; i < code_length; ++i, ++dest_data)
@@ -290,12 +628,10 @@ namespace schifra
          }
       }
 
-      template <typename T, std::size_t code_length, std::size_t fec_length, std::size_t stack_size>
-      inline void copy(const block<code_length,fec_length> src_block_stack[stack_size],
+      template <typename T, std::size_t code_length, std::size_t fec_length, std::size_t stack_size, std::size_t data_length, typename S>
+      inline void copy(const block<code_length,fec_length,data_length,S> src_block_stack[stack_size],
                        T dest_data[])
       {
-         const std::size_t data_length = code_length - fec_length;
-
          for (std::size_t i = 0; i < stack_size; ++i)
          {
             for (std::size_t j = 0; j < data_length; ++j, ++dest_data)
@@ -305,8 +641,8 @@ namespace schifra
          }
       }
 
-      template <std::size_t code_length, std::size_t fec_length>
-      inline std::ostream& operator<<(std::ostream& os, const block<code_length,fec_length>& rs_block)
+      template <std::size_t code_length, std::size_t fec_length, std::size_t data_length, typename S>
+      inline std::ostream& operator<<(std::ostream& os, const block<code_length,fec_length,data_length,S>& rs_block)
       {
          for (std::size_t i = 0; i < code_length; ++i)
          {
@@ -375,6 +711,12 @@ namespace schifra
 
       typedef std::vector<std::size_t> erasure_locations_t;
 
+      inline const erasure_locations_t& empty_erasure_list()
+      {
+         static const erasure_locations_t erasure_list;
+         return erasure_list;
+      }
+
    } // namespace reed_solomon
 
 } // namepsace schifra
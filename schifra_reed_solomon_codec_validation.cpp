@@ -28,7 +28,9 @@
 int main()
 {
    bool codec_validation_result = schifra::reed_solomon::codec_validation_test00() &&
-                                  schifra::reed_solomon::codec_validation_test01() ;
+                                  schifra::reed_solomon::codec_validation_test01() &&
+                                  schifra::reed_solomon::codec_validation_test02() &&
+                                  schifra::reed_solomon::codec_validation_test03() ;
 
    if (codec_validation_result)
    {
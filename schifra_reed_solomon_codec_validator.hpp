@@ -34,6 +34,7 @@
 #include "schifra_reed_solomon_block.hpp"
 #include "schifra_reed_solomon_encoder.hpp"
 #include "schifra_reed_solomon_decoder.hpp"
+#include "schifra_reed_solomon_runtime_codec.hpp"
 #include "schifra_ecc_traits.hpp"
 #include "schifra_error_processes.hpp"
 #include "schifra_utilities.hpp"
@@ -58,13 +59,15 @@ namespace schifra
 
          codec_validator(const galois::field& gf,
                          const unsigned int gpii,
-                         const std::string& msg)
+                         const std::string& msg,
+                         const key_equation_solver::type solver = key_equation_solver::berlekamp_massey)
          : field_(gf),
            generator_polynomial_(galois::field_polynomial(field_)),
            rs_encoder_(reinterpret_cast<encoder_type*>(0)),
            rs_decoder_(reinterpret_cast<decoder_type*>(0)),
            message(msg),
            genpoly_initial_index_(gpii),
+           solver_(solver),
            blocks_processed_(0),
            block_failures_(0)
          {
@@ -81,7 +84,7 @@ namespace schifra
             }
 
             rs_encoder_ = new encoder_type(field_,generator_polynomial_);
-            rs_decoder_ = new decoder_type(field_,genpoly_initial_index_);
+            rs_decoder_ = new decoder_type(field_,genpoly_initial_index_,solver);
 
             if (!rs_encoder_->encode(message,rs_block_original))
             {
@@ -106,7 +109,10 @@ namespace schifra
                           stage9() &&
                          stage10() &&
                          stage11() &&
-                         stage12() ;
+                         stage12() &&
+                         stage13() &&
+                         stage14() &&
+                         stage15() ;
 
             timer.stop();
 
@@ -788,6 +794,304 @@ namespace schifra
             return (block_failures_ == initial_failure_count);
          }
 
+         bool stage13()
+         {
+            /* Batched Burst Errors And Burst Erasures */
+
+            const std::size_t initial_failure_count = block_failures_;
+
+            std::vector<block_type> rs_block_list(code_length);
+            std::vector<erasure_locations_t> erasure_lists(code_length);
+            batch_result result;
+
+            for (std::size_t error_count = 0; error_count <= (fec_length >> 1); ++error_count)
+            {
+               for (std::size_t start_position = 0; start_position < code_length; ++start_position)
+               {
+                  rs_block_list[start_position] = rs_block_original;
+
+                  corrupt_message_all_errors
+                  (
+                    rs_block_list[start_position],
+                    error_count,
+                    start_position,
+                    1
+                  );
+               }
+
+               if (
+                    !rs_decoder_->decode_batch(&rs_block_list[0],code_length,0,result) ||
+                    (result.clean             != ((0 == error_count) ? code_length : 0)) ||
+                    (result.corrected         != ((0 == error_count) ? 0 : code_length)) ||
+                    (result.symbols_corrected != (error_count * code_length))
+                  )
+               {
+                  print_codec_properties();
+                  std::cout << "stage13() - Batch Decoding Failure! error count: " << error_count << std::endl;
+                  ++block_failures_;
+               }
+
+               for (std::size_t i = 0; i < code_length; ++i)
+               {
+                  if (!is_block_equivelent(rs_block_list[i],message))
+                  {
+                     print_codec_properties();
+                     std::cout << "stage13() - Error Correcting Failure! start position: " << i << std::endl;
+                     ++block_failures_;
+                  }
+               }
+
+               blocks_processed_ += code_length;
+            }
+
+            for (std::size_t erasure_count = 1; erasure_count <= fec_length; ++erasure_count)
+            {
+               for (std::size_t start_position = 0; start_position < code_length; ++start_position)
+               {
+                  rs_block_list[start_position] = rs_block_original;
+                  erasure_lists[start_position].clear();
+
+                  corrupt_message_all_erasures
+                  (
+                    rs_block_list[start_position],
+                    erasure_lists[start_position],
+                    erasure_count,
+                    start_position,
+                    1
+                  );
+               }
+
+               if (
+                    !rs_decoder_->decode_batch(&rs_block_list[0],code_length,&erasure_lists[0],result) ||
+                    (0 != result.failed) ||
+                    ((result.clean + result.corrected) != code_length)
+                  )
+               {
+                  print_codec_properties();
+                  std::cout << "stage13() - Batch Decoding Failure! erasure count: " << erasure_count << std::endl;
+                  ++block_failures_;
+               }
+
+               for (std::size_t i = 0; i < code_length; ++i)
+               {
+                  if (!is_block_equivelent(rs_block_list[i],message))
+                  {
+                     print_codec_properties();
+                     std::cout << "stage13() - Erasure Correcting Failure! start position: " << i << std::endl;
+                     ++block_failures_;
+                  }
+               }
+
+               blocks_processed_ += code_length;
+            }
+
+            erasure_locations_t erasure_list;
+
+            for (std::size_t erasure_count = 1; erasure_count <= fec_length; ++erasure_count)
+            {
+               /*
+                  One erasure list shared by the whole batch, plus as many
+                  errors per block as the remaining redundancy allows, each
+                  block having its errors at differing positions.
+               */
+
+               const std::size_t error_count = (fec_length - erasure_count) >> 1;
+
+               erasure_list.clear();
+
+               for (std::size_t i = 0; i < erasure_count; ++i)
+               {
+                  erasure_list.push_back(i);
+               }
+
+               for (std::size_t i = 0; i < code_length; ++i)
+               {
+                  rs_block_list[i] = rs_block_original;
+
+                  for (std::size_t j = 0; j < erasure_count; ++j)
+                  {
+                     add_erasure_error(erasure_list[j],rs_block_list[i]);
+                  }
+
+                  for (std::size_t j = 0; j < error_count; ++j)
+                  {
+                     add_error(erasure_count + ((i + j) % (code_length - erasure_count)),rs_block_list[i]);
+                  }
+               }
+
+               if (
+                    !rs_decoder_->decode_batch(&rs_block_list[0],code_length,erasure_list,result) ||
+                    ((result.clean + result.corrected) != code_length)
+                  )
+               {
+                  print_codec_properties();
+                  std::cout << "stage13() - Shared Erasure Batch Decoding Failure! erasure count: " << erasure_count << std::endl;
+                  ++block_failures_;
+               }
+
+               for (std::size_t i = 0; i < code_length; ++i)
+               {
+                  if (!is_block_equivelent(rs_block_list[i],message))
+                  {
+                     print_codec_properties();
+                     std::cout << "stage13() - Shared Erasure Correcting Failure! block: " << i << std::endl;
+                     ++block_failures_;
+                  }
+               }
+
+               blocks_processed_ += code_length;
+            }
+
+            return (block_failures_ == initial_failure_count);
+         }
+
+         bool stage14()
+         {
+            /* Runtime Codec: Parity Equivalence And Interleaved Error and Erasure Combinations */
+
+            const std::size_t initial_failure_count = block_failures_;
+
+            const runtime_codec codec(field_, code_length, fec_length, genpoly_initial_index_, solver_);
+
+            if (!codec.valid())
+            {
+               print_codec_properties();
+               std::cout << "stage14() - Invalid Runtime Codec!" << std::endl;
+               return false;
+            }
+
+            block_type rs_block = rs_block_original;
+
+            rs_block.clear_fec();
+
+            if (!codec.encode(&rs_block[0]))
+            {
+               print_codec_properties();
+               std::cout << "stage14() - Encoding Failure!" << std::endl;
+               ++block_failures_;
+            }
+
+            for (std::size_t i = 0; i < code_length; ++i)
+            {
+               if (rs_block[i] != rs_block_original[i])
+               {
+                  print_codec_properties();
+                  std::cout << "stage14() - Encoding Discrepancy! position: " << i << std::endl;
+                  ++block_failures_;
+                  break;
+               }
+            }
+
+            runtime_codec::workspace workspace(fec_length);
+            runtime_codec::status    status;
+            erasure_locations_t      erasure_list;
+
+            for (std::size_t erasure_count = 0; erasure_count <= fec_length; ++erasure_count)
+            {
+               for (std::size_t start_position = 0; start_position < code_length; ++start_position)
+               {
+                  rs_block = rs_block_original;
+
+                  corrupt_message_interleaved_errors_erasures
+                  (
+                    rs_block,
+                    start_position,
+                    erasure_count,
+                    erasure_list
+                  );
+
+                  if (!codec.decode(&rs_block[0],erasure_list,status,workspace))
+                  {
+                     print_codec_properties();
+                     std::cout << "stage14() - Decoding Failure! start position: " << start_position << std::endl;
+                     ++block_failures_;
+                  }
+                  else if (!is_block_equivelent(rs_block,message))
+                  {
+                     print_codec_properties();
+                     std::cout << "stage14() - Error Correcting Failure! start position: " << start_position << std::endl;
+                     ++block_failures_;
+                  }
+                  else if (status.errors_detected != status.errors_corrected)
+                  {
+                     print_codec_properties();
+                     std::cout << "stage14() - Discrepancy between the number of errors detected and corrected. [" << status.errors_detected << "," << status.errors_corrected << "]" << std::endl;
+                     ++block_failures_;
+                  }
+
+                  ++blocks_processed_;
+                  erasure_list.clear();
+               }
+            }
+
+            return (block_failures_ == initial_failure_count);
+         }
+
+         bool stage15()
+         {
+            /* One Workspace Alternated Between Decoders Of Different Generator Initial Indices */
+
+            const std::size_t initial_failure_count = block_failures_;
+
+            const unsigned int other_initial_index = genpoly_initial_index_ + 1;
+
+            galois::field_polynomial other_generator(field_);
+
+            if (!make_sequential_root_generator_polynomial(field_, other_initial_index, fec_length, other_generator))
+            {
+               print_codec_properties();
+               std::cout << "stage15() - Failed to create generator polynomial!" << std::endl;
+               return false;
+            }
+
+            const encoder_type other_encoder(field_, other_generator);
+            const decoder_type other_decoder(field_, other_initial_index, solver_);
+
+            block_type other_original;
+
+            if (!other_encoder.encode(message, other_original))
+            {
+               print_codec_properties();
+               std::cout << "stage15() - Encoding Failure!" << std::endl;
+               return false;
+            }
+
+            typename decoder_type::workspace workspace;
+
+            erasure_locations_t erasure_list;
+
+            for (std::size_t start_position = 0; start_position < code_length; ++start_position)
+            {
+               for (std::size_t i = 0; i < 2; ++i)
+               {
+                  const decoder_type& rs_decoder = (0 == i) ? *rs_decoder_ : other_decoder;
+
+                  block_type rs_block = (0 == i) ? rs_block_original : other_original;
+
+                  erasure_list.clear();
+
+                  corrupt_message_all_erasures(rs_block, erasure_list, fec_length, start_position);
+
+                  if (!rs_decoder.decode(rs_block, erasure_list, workspace))
+                  {
+                     print_codec_properties();
+                     std::cout << "stage15() - Decoding Failure! start position: " << start_position << std::endl;
+                     ++block_failures_;
+                  }
+                  else if (!is_block_equivelent(rs_block,message))
+                  {
+                     print_codec_properties();
+                     std::cout << "stage15() - Error Correcting Failure! start position: " << start_position << std::endl;
+                     ++block_failures_;
+                  }
+
+                  ++blocks_processed_;
+               }
+            }
+
+            return (block_failures_ == initial_failure_count);
+         }
+
       protected:
 
          codec_validator() {}
@@ -804,6 +1108,7 @@ namespace schifra
          block_type rs_block_original;
          const std::string&  message;
          const unsigned int genpoly_initial_index_;
+         const key_equation_solver::type solver_;
          unsigned int blocks_processed_;
          unsigned int block_failures_;
       };
@@ -907,7 +1212,9 @@ namespace schifra
       }
 
       template <std::size_t field_descriptor, std::size_t gen_poly_index, std::size_t code_length, std::size_t fec_length>
-      inline bool codec_validation_test(const std::size_t prim_poly_size,const unsigned int prim_poly[])
+      inline bool codec_validation_test(const std::size_t prim_poly_size,
+                                        const unsigned int prim_poly[],
+                                        const key_equation_solver::type solver = key_equation_solver::berlekamp_massey)
       {
          const unsigned int data_length = code_length - fec_length;
 
@@ -918,7 +1225,7 @@ namespace schifra
          for (std::size_t i = 0; i < message_list.size(); ++i)
          {
             codec_validator<code_length,fec_length>
-               validator(field, gen_poly_index, message_list[i]);
+               validator(field, gen_poly_index, message_list[i], solver);
 
             if (!validator.execute())
             {
@@ -991,6 +1298,28 @@ namespace schifra
                 shortened_codec_validation_test<8,120, 72,10>(galois::primitive_polynomial_size06,galois::primitive_polynomial06) ;  /* VDL Mode 3 RS Code */
       }
 
+      inline bool codec_validation_test02()
+      {
+         const key_equation_solver::type ibm = key_equation_solver::inversionless_berlekamp_massey;
+
+         return codec_validation_test<8,120,255,  2>(galois::primitive_polynomial_size06,galois::primitive_polynomial06,ibm) &&
+                codec_validation_test<8,120,255,  6>(galois::primitive_polynomial_size06,galois::primitive_polynomial06,ibm) &&
+                codec_validation_test<8,120,255, 16>(galois::primitive_polynomial_size06,galois::primitive_polynomial06,ibm) &&
+                codec_validation_test<8,120,255, 32>(galois::primitive_polynomial_size06,galois::primitive_polynomial06,ibm) &&
+                codec_validation_test<8,  1,255, 64>(galois::primitive_polynomial_size05,galois::primitive_polynomial05,ibm) ;
+      }
+
+      inline bool codec_validation_test03()
+      {
+         const key_equation_solver::type euc = key_equation_solver::euclidean;
+
+         return codec_validation_test<8,120,255,  2>(galois::primitive_polynomial_size06,galois::primitive_polynomial06,euc) &&
+                codec_validation_test<8,120,255,  6>(galois::primitive_polynomial_size06,galois::primitive_polynomial06,euc) &&
+                codec_validation_test<8,120,255, 16>(galois::primitive_polynomial_size06,galois::primitive_polynomial06,euc) &&
+                codec_validation_test<8,120,255, 32>(galois::primitive_polynomial_size06,galois::primitive_polynomial06,euc) &&
+                codec_validation_test<8,  1,255, 64>(galois::primitive_polynomial_size05,galois::primitive_polynomial05,euc) ;
+      }
+
    } // namespace reed_solomon
 
 } // namespace schifra
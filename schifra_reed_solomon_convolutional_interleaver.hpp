@@ -0,0 +1,228 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+#ifndef INCLUDE_SCHIFRA_REED_SOLOMON_CONVOLUTIONAL_INTERLEAVER_HPP
+#define INCLUDE_SCHIFRA_REED_SOLOMON_CONVOLUTIONAL_INTERLEAVER_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "schifra_reed_solomon_block.hpp"
+
+
+namespace schifra
+{
+
+   namespace reed_solomon
+   {
+
+      namespace details
+      {
+         template <typename T, bool descending>
+         class convolutional_delay_lines
+         {
+         public:
+
+            /*
+              The branch_count branches of a Forney (Ramsey type III)
+              convolutional interleaver, the commutator visiting one branch
+              per symbol in turn. Branch j delays its symbols by
+              j * cell_depth cells - or, descending, by
+              (branch_count - 1 - j) * cell_depth cells, which undoes the
+              former. The branches are rings laid end to end within the one
+              cell buffer. Without any branches there is no commutator to
+              speak of, hence symbols are passed through undelayed.
+            */
+
+            convolutional_delay_lines(const std::size_t branch_count,
+                                      const std::size_t cell_depth)
+            : branch_count_(branch_count),
+              cell_depth_(cell_depth),
+              valid_(0 < branch_count),
+              branch_(branch_count),
+              commutator_(0)
+            {
+               std::size_t offset = 0;
+
+               for (std::size_t j = 0; j < branch_count_; ++j)
+               {
+                  branch_[j].offset = offset;
+                  branch_[j].length = (descending ? (branch_count_ - 1 - j) : j) * cell_depth_;
+                  offset += branch_[j].length;
+               }
+
+               cell_.resize(offset);
+
+               reset();
+            }
+
+            inline void reset(const T value = T(0))
+            {
+               std::fill(cell_.begin(), cell_.end(), value);
+
+               for (std::size_t j = 0; j < branch_count_; ++j)
+               {
+                  branch_[j].position = 0;
+               }
+
+               commutator_ = 0;
+            }
+
+            inline bool valid() const
+            {
+               return valid_;
+            }
+
+            inline T process(const T symbol)
+            {
+               if (!valid_)
+               {
+                  return symbol;
+               }
+
+               branch& b = branch_[commutator_];
+
+               if (++commutator_ == branch_count_)
+               {
+                  commutator_ = 0;
+               }
+
+               if (0 == b.length)
+               {
+                  return symbol;
+               }
+
+               T& cell = cell_[b.offset + b.position];
+
+               const T result = cell;
+
+               cell = symbol;
+
+               if (++b.position == b.length)
+               {
+                  b.position = 0;
+               }
+
+               return result;
+            }
+
+            inline void process(const T input[], T output[], const std::size_t length)
+            {
+               for (std::size_t i = 0; i < length; ++i)
+               {
+                  output[i] = process(input[i]);
+               }
+            }
+
+            template <std::size_t block_length>
+            inline void process(data_block<T,block_length>& block)
+            {
+               process(block.begin(), block.begin(), block_length);
+            }
+
+            template <std::size_t block_length>
+            inline void process(const data_block<T,block_length>& input, data_block<T,block_length>& output)
+            {
+               process(input.begin(), output.begin(), block_length);
+            }
+
+            inline std::size_t branch_count() const
+            {
+               return branch_count_;
+            }
+
+            inline std::size_t cell_depth() const
+            {
+               return cell_depth_;
+            }
+
+            inline std::size_t memory() const
+            {
+               return cell_.size();
+            }
+
+            inline std::size_t delay() const
+            {
+               // End to end, that is together with the opposite direction
+               return 2 * cell_.size();
+            }
+
+         private:
+
+            struct branch
+            {
+               std::size_t offset;
+               std::size_t length;
+               std::size_t position;
+            };
+
+            const std::size_t   branch_count_;
+            const std::size_t   cell_depth_;
+            const bool          valid_;
+            std::vector<branch> branch_;
+            std::vector<T>      cell_;
+            std::size_t         commutator_;
+         };
+
+      } // namespace details
+
+      /*
+        Convolutional interleaving operates upon a stream, one symbol in
+        one symbol out, rather than upon a whole stack. With I branches and
+        a cell depth of M, consecutive symbols upon the channel are I * M - 1
+        symbols apart in the deinterleaved stream, so that a burst of up to
+        I * t symbols leaves at most t errors in any codeword of I * M
+        symbols (eg: DVB uses I = 12 and M = 17 with RS(204,188), t = 8
+        correcting bursts of 96 symbols). The interleaver and deinterleaver
+        each hold I(I-1)M/2 symbols, and together delay the stream by
+        I(I-1)M symbols - about half of the memory and delay of a block
+        interleaver of the same spread. The delayed symbols at the start
+        of the stream are the reset value.
+      */
+
+      template <typename T>
+      class convolutional_interleaver : public details::convolutional_delay_lines<T,false>
+      {
+      public:
+
+         convolutional_interleaver(const std::size_t branch_count, const std::size_t cell_depth)
+         : details::convolutional_delay_lines<T,false>(branch_count, cell_depth)
+         {}
+      };
+
+      template <typename T>
+      class convolutional_deinterleaver : public details::convolutional_delay_lines<T,true>
+      {
+      public:
+
+         convolutional_deinterleaver(const std::size_t branch_count, const std::size_t cell_depth)
+         : details::convolutional_delay_lines<T,true>(branch_count, cell_depth)
+         {}
+      };
+
+   } // namespace reed_solomon
+
+} // namespace schifra
+
+#endif
@@ -24,10 +24,16 @@
 #define INCLUDE_SCHIFRA_REED_SOLOMON_DECODER_HPP
 
 
+#include <algorithm>
+#include <vector>
+
 #include "schifra_galois_field.hpp"
 #include "schifra_galois_field_element.hpp"
 #include "schifra_galois_field_polynomial.hpp"
+#include "schifra_galois_field_region.hpp"
 #include "schifra_reed_solomon_block.hpp"
+#include "schifra_reed_solomon_erasure_recovery.hpp"
+#include "schifra_reed_solomon_kernels.hpp"
 #include "schifra_ecc_traits.hpp"
 
 
@@ -36,361 +42,1476 @@ namespace schifra
    namespace reed_solomon
    {
 
-      template <std::size_t code_length, std::size_t fec_length, std::size_t data_length = code_length - fec_length>
-      class decoder
+      namespace key_equation_solver
       {
-      public:
-
-         typedef traits::reed_solomon_triat<code_length,fec_length,data_length> trait;
-         typedef block<code_length,fec_length> block_type;
+         enum type
+         {
+            berlekamp_massey               = 0,
+            inversionless_berlekamp_massey = 1,
+            euclidean                      = 2
+         };
 
-         decoder(const galois::field& field, const unsigned int& gen_initial_index = 0)
-         : decoder_valid_(field.size() == code_length),
-           field_(field),
-           X_(galois::generate_X(field_)),
-           gen_initial_index_(gen_initial_index)
+         inline std::string to_string(const type solver)
          {
-            if (decoder_valid_)
+            switch (solver)
             {
-               //Note: code_length and field size can be used interchangeably
-               create_lookup_tables();
+               case berlekamp_massey               : return "BM";
+               case inversionless_berlekamp_massey : return "iBM";
+               case euclidean                      : return "Euclidean";
+               default                             : return "Invalid Solver";
             }
-         };
+         }
+      }
 
-         const galois::field& field() const
+      struct batch_result
+      {
+         /*
+           The aggregate counters of a decode_batch call. A batch is a
+           convenience loop over the blocks, decoding each in turn with
+           the one workspace - the blocks are not decoded side by side.
+         */
+
+         batch_result()
          {
-            return field_;
+            clear();
          }
 
-         bool decode(block_type& rsblock) const
+         void clear()
          {
-            std::vector<std::size_t> erasure_list;
-            return decode(rsblock,erasure_list);
+            clean             = 0;
+            corrected         = 0;
+            failed            = 0;
+            symbols_corrected = 0;
          }
 
-         bool decode(block_type& rsblock, const erasure_locations_t& erasure_list) const
+         void update(const bool decoded, const std::size_t errors_detected, const std::size_t errors_corrected)
          {
-            if ((!decoder_valid_) || (erasure_list.size() > fec_length))
+            if (!decoded)
+               ++failed;
+            else if (0 == errors_detected)
+               ++clean;
+            else
+               ++corrected;
+
+            symbols_corrected += errors_corrected;
+         }
+
+         std::size_t clean;
+         std::size_t corrected;
+         std::size_t failed;
+         std::size_t symbols_corrected;
+      };
+
+      namespace details
+      {
+         class decoder_core
+         {
+         public:
+
+            /*
+              The decoding algorithms for a code whose parameters (code
+              length, fec length, field and generator initial index) are
+              only known at runtime. A single core is shared by the fixed
+              length decoder below and by the runtime codec.
+              The codeword is anything indexable by symbol position, the
+              decoding state is reported through the block's fields and
+              error codes, and all scratch space is provided by a caller
+              owned workspace, which must hold arrays (or vectors) named
+              as per decoder<>::workspace, sized upon the fec length.
+              Codes shorter than the field (code_length < field size) are
+              decoded natively, the padding symbols being implicitly zero.
+              The syndrome computation and the Chien search are bound to
+              the vectorised kernels of the active cpu level, whenever the
+              kernels are valid for the code, otherwise to the scalar ones.
+            */
+
+            enum { erasure_cache_size = 4 };
+
+            decoder_core(const galois::field&            field,
+                         const std::size_t               code_length,
+                         const std::size_t               fec_length,
+                         const unsigned int              gen_initial_index,
+                         const key_equation_solver::type solver)
+            : field_(field),
+              code_length_(code_length),
+              fec_length_(fec_length),
+              padding_length_(field.size() - code_length),
+              gen_initial_index_(gen_initial_index),
+              solver_(solver),
+              valid_(
+                      (0 < fec_length)             &&
+                      (fec_length < code_length)   &&
+                      (code_length <= field.size())
+                    ),
+              root_exponent_step_((1 + field.size() - (gen_initial_index % field.size())) % field.size()),
+              syndrome_exponent_table_(make_syndrome_exponent_table(field, fec_length, gen_initial_index)),
+              multiplier_(field),
+              syndrome_kernel_(multiplier_,
+                               (valid_ ? fec_length : 0),
+                               code_length,
+                               &make_generator_feedback(field, syndrome_exponent_table_)[0]),
+              chien_kernel_(multiplier_, field, fec_length)
             {
-               rsblock.errors_detected  = 0;
-               rsblock.errors_corrected = 0;
-               rsblock.zero_numerators  = 0;
-               rsblock.unrecoverable    = true;
-               rsblock.error            = block_type::e_decoder_error0;
+               if (valid_)
+               {
+                  /*
+                    The syndrome kernel computes R(x) = (r(x) * x^fec_length)
+                    mod g(x), and r(b) = R(b) * b^-fec_length at each root b
+                    of g(x), hence: syndrome[i] = sum(R[j] * b[i]^-(j + 1)).
+                  */
+                  std::vector<galois::field_symbol> evaluation(fec_length_ * fec_length_);
+
+                  for (std::size_t i = 0; i < fec_length_; ++i)
+                  {
+                     const galois::field_symbol inverse_root = field_.inverse(syndrome_exponent_table_[i]);
 
-               return false;
+                     galois::field_symbol power = inverse_root;
+
+                     for (std::size_t j = 0; j < fec_length_; ++j)
+                     {
+                        evaluation[(j * fec_length_) + i] = power;
+                        power = field_.mul(power, inverse_root);
+                     }
+                  }
+
+                  syndrome_kernel_.transform(evaluation);
+               }
+            }
+
+            inline bool valid() const
+            {
+               return valid_;
+            }
+
+            inline key_equation_solver::type solver() const
+            {
+               return solver_;
+            }
+
+            template <typename Codeword, typename State, typename Workspace>
+            bool decode(Codeword& codeword, State& state, const erasure_locations_t& erasure_list, Workspace& ws) const
+            {
+               if ((!valid_) || (erasure_list.size() > fec_length_))
+               {
+                  state.errors_detected  = 0;
+                  state.errors_corrected = 0;
+                  state.zero_numerators  = 0;
+                  state.unrecoverable    = true;
+                  state.error            = State::e_decoder_error0;
+
+                  return false;
+               }
+
+               galois::field_symbol* syndrome = &ws.syndrome[0];
+               galois::field_symbol* lambda   = &ws.lambda  [0];
+               galois::field_symbol* omega    = &ws.omega   [0];
+
+               if (compute_syndrome(codeword, syndrome) == 0)
+               {
+                  state.errors_detected  = 0;
+                  state.errors_corrected = 0;
+                  state.zero_numerators  = 0;
+                  state.unrecoverable    = false;
+
+                  return true;
+               }
+
+               typedef typename Workspace::erasure_pattern erasure_pattern;
+
+               const erasure_pattern* pattern = 0;
+
+               if (erasure_list.empty())
+               {
+                  compute_gamma(lambda, 0, 0);
+               }
+               else
+               {
+                  pattern = &lookup_erasure_pattern(erasure_list, ws);
+
+                  std::copy(&pattern->gamma[0], &pattern->gamma[0] + fec_length_ + 1, lambda);
+
+                  if (pattern->valid && erasures_only(&pattern->gamma[0], pattern->erasure_count, syndrome, omega))
+                  {
+                     /*
+                        Erasures only: the locations are known, hence neither
+                        the key equation solver nor the Chien search is run.
+                     */
+
+                     state.errors_detected = pattern->erasure_count;
+
+                     return forney_algorithm(*pattern, 1, omega, codeword, state);
+                  }
+               }
+
+               if (key_equation_solver::inversionless_berlekamp_massey == solver_)
+               {
+                  inversionless_berlekamp_massey_algorithm(lambda, omega, syndrome, erasure_list.size(),
+                                                           &ws.scratch[0][0], &ws.scratch[1][0]);
+               }
+               else if (key_equation_solver::euclidean == solver_)
+               {
+                  if (
+                       !euclidean_algorithm(lambda, omega, syndrome, erasure_list.size(),
+                                            &ws.scratch[0][0], &ws.scratch[1][0], &ws.scratch[2][0],
+                                            &ws.scratch[3][0], &ws.scratch[4][0])
+                     )
+                  {
+                     /*
+                        The Euclidean algorithm bounds the degree of the error
+                        locator, hence beyond the code's capability it may not
+                        yield a valid (lambda,omega) pair, whereas the BMA would
+                        have instead yielded a locator of excessive degree.
+                     */
+
+                     state.errors_detected  = 0;
+                     state.errors_corrected = 0;
+                     state.zero_numerators  = 0;
+                     state.unrecoverable    = true;
+                     state.error            = State::e_decoder_error2;
+
+                     return false;
+                  }
+               }
+               else
+               {
+                  if (erasure_list.size() < fec_length_)
+                  {
+                     modified_berlekamp_massey_algorithm(lambda, syndrome, erasure_list.size(), &ws.scratch[0][0]);
+                  }
+
+                  compute_omega(lambda, syndrome, omega);
+               }
+
+               const int lambda_degree = degree(lambda, fec_length_ + 1);
+
+               if (
+                    (0 != pattern)     &&
+                    (pattern->valid)   &&
+                    (lambda_degree == static_cast<int>(pattern->erasure_count))
+                  )
+               {
+                  /*
+                     The errata locator is always a multiple of gamma, hence
+                     being of equal degree it is a scalar multiple of gamma:
+                     no errors beyond the erasures, the roots are already
+                     known and the Chien search is not required.
+                  */
+
+                  state.errors_detected = pattern->erasure_count;
+
+                  return forney_algorithm(*pattern, lambda[0], omega, codeword, state);
+               }
+
+               const std::size_t error_count = find_roots(lambda, lambda_degree,
+                                                          &ws.error_locations[0], &ws.odd_sums[0],
+                                                          &ws.scratch[0][0], &ws.scratch[1][0]);
+
+               if (0 == error_count)
+               {
+                  /*
+                    Syndrome is non-zero yet no error locations have
+                    been obtained, conclusion:
+                    It is possible that there are MORE errrors in the
+                    message than can be detected and corrected for this
+                    particular code.
+                  */
+
+                  state.errors_detected  = 0;
+                  state.errors_corrected = 0;
+                  state.zero_numerators  = 0;
+                  state.unrecoverable    = true;
+                  state.error            = State::e_decoder_error1;
+
+                  return false;
+               }
+               else if (((2 * error_count) - erasure_list.size()) > fec_length_)
+               {
+                  /*
+                     Too many errors\erasures! 2E + S <= fec_length
+                      L =  E + S
+                      E =  L - S
+                     2E = 2L - 2S
+                     2E + S = 2L - 2S + S
+                            = 2L - S
+                    Where:
+                     L : Error Locations
+                     E : Errors
+                     S : Erasures
+
+                  */
+
+                  state.errors_detected  = error_count;
+                  state.errors_corrected = 0;
+                  state.zero_numerators  = 0;
+                  state.unrecoverable    = true;
+                  state.error            = State::e_decoder_error2;
+
+                  return false;
+               }
+               else
+                  state.errors_detected  = error_count;
+
+               return forney_algorithm(&ws.error_locations[0], &ws.odd_sums[0], error_count, lambda_degree, omega, codeword, state);
+            }
+
+         private:
+
+            decoder_core(const decoder_core&);
+            decoder_core& operator=(const decoder_core&);
+
+            inline galois::field_symbol root_exponent(const int location) const
+            {
+               // alpha^((n - location) * (1 - gen_initial_index))
+
+               const std::size_t field_size = field_.size();
+               const std::size_t exponent   = ((field_size - location) % field_size) * root_exponent_step_;
+
+               return field_.alpha(static_cast<galois::field_symbol>(exponent % field_size));
+            }
+
+            static std::vector<galois::field_symbol> make_syndrome_exponent_table(const galois::field& field,
+                                                                                  const std::size_t    fec_length,
+                                                                                  const unsigned int   gen_initial_index)
+            {
+               std::vector<galois::field_symbol> table(fec_length);
+
+               for (std::size_t i = 0; i < fec_length; ++i)
+               {
+                  table[i] = field.alpha(gen_initial_index + static_cast<unsigned int>(i));
+               }
+
+               return table;
+            }
+
+            static std::vector<galois::field_symbol> make_generator_feedback(const galois::field&                     field,
+                                                                             const std::vector<galois::field_symbol>& roots)
+            {
+               /*
+                 The feedback table of the monic generator whose roots are
+                 those of the syndromes: feedback[k] = g[fec_length - 1 - k]
+               */
+
+               const std::size_t fec_length = roots.size();
+
+               std::vector<galois::field_symbol> g(fec_length + 1, 0);
+
+               g[0] = 1;
+
+               for (std::size_t i = 0; i < fec_length; ++i)
+               {
+                  for (std::size_t d = i + 1; d > 0; --d)
+                  {
+                     g[d] = g[d - 1] ^ field.mul(g[d], roots[i]);
+                  }
+
+                  g[0] = field.mul(g[0], roots[i]);
+               }
+
+               std::vector<galois::field_symbol> feedback(fec_length + 1, 0);
+
+               for (std::size_t k = 0; k < fec_length; ++k)
+               {
+                  feedback[k] = g[fec_length - 1 - k];
+               }
+
+               return feedback;
+            }
+
+            void compute_gamma(galois::field_symbol gamma[], const std::size_t erasures[], const std::size_t erasure_count) const
+            {
+               /*
+                 Erasure locator: gamma = product of (1 + alpha^location * x)
+                 taken over all erasure locations.
+               */
+
+               std::fill_n(gamma, fec_length_ + 1, galois::field_symbol(0));
+
+               gamma[0] = 1;
+
+               for (std::size_t i = 0; i < erasure_count; ++i)
+               {
+                  const galois::field_symbol root = field_.alpha(static_cast<int>(code_length_ - 1 - erasures[i]));
+
+                  for (std::size_t j = i + 1; j > 0; --j)
+                  {
+                     gamma[j] ^= field_.mul(gamma[j - 1], root);
+                  }
+               }
+            }
+
+            template <typename Codeword>
+            inline int compute_syndrome(const Codeword& codeword, galois::field_symbol syndrome[]) const
+            {
+               if (syndrome_kernel_.valid())
+               {
+                  unsigned char s[remainder_kernel::max_fec_length];
+
+                  if (!syndrome_kernel_.compute(codeword, s))
+                  {
+                     std::fill_n(syndrome, fec_length_, galois::field_symbol(0));
+                     return 0;
+                  }
+
+                  int error_flag = 0;
+
+                  for (std::size_t i = 0; i < fec_length_; ++i)
+                  {
+                     syndrome[i]  = s[i];
+                     error_flag  |= s[i];
+                  }
+
+                  return error_flag;
+               }
+
+               switch (fec_length_)
+               {
+                  case   2 : return syndrome_kernel<  2>(codeword, syndrome);
+                  case   4 : return syndrome_kernel<  4>(codeword, syndrome);
+                  case   6 : return syndrome_kernel<  6>(codeword, syndrome);
+                  case   8 : return syndrome_kernel<  8>(codeword, syndrome);
+                  case  10 : return syndrome_kernel< 10>(codeword, syndrome);
+                  case  12 : return syndrome_kernel< 12>(codeword, syndrome);
+                  case  16 : return syndrome_kernel< 16>(codeword, syndrome);
+                  case  20 : return syndrome_kernel< 20>(codeword, syndrome);
+                  case  24 : return syndrome_kernel< 24>(codeword, syndrome);
+                  case  32 : return syndrome_kernel< 32>(codeword, syndrome);
+                  case  64 : return syndrome_kernel< 64>(codeword, syndrome);
+                  default  : return syndrome_kernel<  0>(codeword, syndrome);
+               }
+            }
+
+            template <std::size_t fixed_fec_length, typename Codeword>
+            inline int syndrome_kernel(const Codeword& codeword, galois::field_symbol syndrome[]) const
+            {
+               /*
+                 Evaluate the received message, taken in reverse order
+                 (ie: codeword[0] is the highest order term), at each of
+                 the generator polynomial's roots. All fec_length Horner
+                 recurrences are advanced together, one message symbol at
+                 a time, so they do not serialise on each other. Kernels
+                 specialised upon the common fec lengths (fixed_fec_length
+                 > 0) keep the recurrences in a fixed size local array.
+               */
+
+               const std::size_t fec_length = (fixed_fec_length ? fixed_fec_length : fec_length_);
+               const galois::field_symbol* exponent_table = &syndrome_exponent_table_[0];
+
+               galois::field_symbol  local_syndrome[fixed_fec_length ? fixed_fec_length : 1];
+               galois::field_symbol* s = (fixed_fec_length ? local_syndrome : syndrome);
+
+               std::fill_n(s, fec_length, galois::field_symbol(0));
+
+               for (std::size_t j = 0; j < code_length_; ++j)
+               {
+                  const galois::field_symbol symbol = codeword[j];
+
+                  for (std::size_t i = 0; i < fec_length; ++i)
+                  {
+                     s[i] = field_.mul(s[i], exponent_table[i]) ^ symbol;
+                  }
+               }
+
+               int error_flag = 0;
+
+               for (std::size_t i = 0; i < fec_length; ++i)
+               {
+                  syndrome[i]  = s[i];
+                  error_flag  |= s[i];
+               }
+
+               return error_flag;
+            }
+
+            template <typename Workspace>
+            const typename Workspace::erasure_pattern& lookup_erasure_pattern(const erasure_locations_t& erasure_list, Workspace& ws) const
+            {
+               typedef typename Workspace::erasure_pattern erasure_pattern;
+
+               const std::size_t erasure_count = erasure_list.size();
+
+               std::size_t* erasure_key = &ws.erasure_key[0];
+
+               std::copy(erasure_list.begin(), erasure_list.end(), erasure_key);
+               std::sort(erasure_key, erasure_key + erasure_count);
+
+               const erasure_cache_owner owner(&field_, code_length_, fec_length_, gen_initial_index_);
+
+               if (!(ws.erasure_cache_owner == owner))
+               {
+                  // Patterns cached by another code are of no use to this one
+                  ws.erasure_cache_entries = 0;
+                  ws.erasure_cache_owner   = owner;
+               }
+
+               bool found = false;
+
+               erasure_pattern& pattern = lookup_cache_entry(&ws.erasure_cache[0],
+                                                             ws.erasure_cache_entries,
+                                                             static_cast<std::size_t>(erasure_cache_size),
+                                                             ws.erasure_cache_clock,
+                                                             erasure_key,
+                                                             erasure_count,
+                                                             found);
+
+               if (!found)
+               {
+                  pattern.erasure_count = erasure_count;
+
+                  std::copy(erasure_key, erasure_key + erasure_count, &pattern.erasures[0]);
+
+                  build_erasure_pattern(pattern);
+               }
+
+               return pattern;
+            }
+
+            template <typename ErasurePattern>
+            void build_erasure_pattern(ErasurePattern& pattern) const
+            {
+               /*
+                 Everything about an erasure set that is independent of the
+                 block contents: the erasure locator (gamma), its roots in
+                 Chien search order, and per root the Forney coefficient
+                 x * root_exponent / (x * gamma'(x)), so that the erasure
+                 magnitudes reduce to omega(x) * coefficient.
+               */
+
+               compute_gamma(&pattern.gamma[0], &pattern.erasures[0], pattern.erasure_count);
+
+               const int gamma_degree = static_cast<int>(pattern.erasure_count);
+
+               pattern.valid = true;
+
+               for (std::size_t i = 0; i < pattern.erasure_count; ++i)
+               {
+                  /*
+                     Erasure position p is the root alpha^(p + 1 + padding) of
+                     gamma, sorted positions hence yield the Chien search order.
+                  */
+                  const int                  location = static_cast<int>(pattern.erasures[i] + 1 + padding_length_);
+                  const galois::field_symbol x        = field_.alpha(location);
+                  const galois::field_symbol x_square = field_.mul(x, x);
+
+                  galois::field_symbol odd_sum = 0;
+                  galois::field_symbol x_power = x;
+
+                  for (int j = 1; j <= gamma_degree; j += 2)
+                  {
+                     odd_sum ^= field_.mul(pattern.gamma[j], x_power);
+                     x_power  = field_.mul(x_power, x_square);
+                  }
+
+                  if (0 == odd_sum)
+                  {
+                     // Only possible with repeated erasure positions
+                     pattern.valid = false;
+                  }
+
+                  pattern.locations  [i] = location;
+                  pattern.coefficient[i] = field_.div(field_.mul(root_exponent(location), x), odd_sum);
+               }
+            }
+
+            bool erasures_only(const galois::field_symbol gamma   [],
+                               const std::size_t          erasure_count,
+                               const galois::field_symbol syndrome[],
+                               galois::field_symbol       omega   []) const
+            {
+               /*
+                  Compute omega = (gamma * syndrome) mod x^fec_length and test
+                  the erasures only hypothesis: its terms of order erasure_count
+                  and above must all be zero. These terms are precisely the
+                  discrepancies the BMA would encounter starting from gamma,
+                  so when they vanish every key equation solver would return
+                  gamma itself as the errata locator.
+               */
+
+               compute_omega(gamma, syndrome, omega);
+
+               for (std::size_t i = erasure_count; i < fec_length_; ++i)
+               {
+                  if (0 != omega[i])
+                     return false;
+               }
+
+               return true;
+            }
+
+            std::size_t find_roots(const galois::field_symbol lambda[],
+                                   const int                  lambda_degree,
+                                   int                        root_list[],
+                                   galois::field_symbol       odd_sum_list[],
+                                   galois::field_symbol       reg[],
+                                   galois::field_symbol       step[]) const
+            {
+               /*
+                  Chien Search: Find the roots of the error locator polynomial
+                  via an exhaustive search over the non-zero elements of the
+                  given finite field that map onto codeword positions. Register
+                  j holds lambda[j] * alpha^(i*j) and is stepped by a single
+                  multiply per candidate. The even and odd register sums are
+                  kept apart, as at a root they are equal, and the odd sum is
+                  x * lambda'(x) which the Forney algorithm requires for the
+                  very same root. For shortened codes the search begins past
+                  the padding, as the registers are first advanced to it.
+               */
+
+               if (lambda_degree <= 0)
+                  return 0;
+
+               const int field_size = static_cast<int>(field_.size());
+               const int padding    = static_cast<int>(padding_length_);
+
+               if (chien_kernel_.valid())
+               {
+                  unsigned char base   [chien_kernel::max_degree + 1];
+                  unsigned char odd_sum[chien_kernel::max_degree + 1];
+
+                  for (int j = 0; j <= lambda_degree; ++j)
+                  {
+                     base[j] = static_cast<unsigned char>(field_.mul(lambda[j], field_.alpha((j * (padding + 1)) % field_size)));
+                  }
+
+                  const std::size_t root_count = chien_kernel_.find_roots(base, lambda_degree, padding + 1, field_size, root_list, odd_sum);
+
+                  for (std::size_t i = 0; i < root_count; ++i)
+                  {
+                     odd_sum_list[i] = odd_sum[i];
+                  }
+
+                  return root_count;
+               }
+
+               for (int j = 0; j <= lambda_degree; ++j)
+               {
+                  reg [j] = field_.mul(lambda[j], field_.alpha((j * padding) % field_size));
+                  step[j] = field_.alpha(j);
+               }
+
+               std::size_t root_count = 0;
+
+               for (int i = padding + 1; i <= field_size; ++i)
+               {
+                  galois::field_symbol even_sum = reg[0];
+                  galois::field_symbol odd_sum  = 0;
+
+                  for (int j = 1; j <= lambda_degree; ++j)
+                  {
+                     reg[j] = field_.mul(reg[j], step[j]);
+
+                     if (j & 1)
+                        odd_sum  ^= reg[j];
+                     else
+                        even_sum ^= reg[j];
+                  }
+
+                  if (even_sum == odd_sum)
+                  {
+                     root_list   [root_count] = i;
+                     odd_sum_list[root_count] = odd_sum;
+
+                     if (static_cast<std::size_t>(lambda_degree) == ++root_count)
+                     {
+                        break;
+                     }
+                  }
+               }
+
+               return root_count;
+            }
+
+            galois::field_symbol compute_discrepancy(const galois::field_symbol lambda[],
+                                                     const galois::field_symbol syndrome[],
+                                                     const std::size_t          l,
+                                                     const std::size_t          round) const
+            {
+               /*
+                  Compute the lambda discrepancy at the current round of BMA
+               */
+
+               galois::field_symbol discrepancy = 0;
+
+               for (std::size_t i = 0; i <= l; ++i)
+               {
+                  discrepancy ^= field_.mul(lambda[i], syndrome[round - i]);
+               }
+
+               return discrepancy;
+            }
+
+            void modified_berlekamp_massey_algorithm(galois::field_symbol       lambda[],
+                                                     const galois::field_symbol syndrome[],
+                                                     const std::size_t          erasure_count,
+                                                     galois::field_symbol       previous_lambda[]) const
+            {
+               /*
+                  Modified Berlekamp-Massey Algorithm
+                  Identify the shortest length linear feed-back shift register (LFSR)
+                  that will generate the sequence equivalent to the syndrome.
+               */
+
+               const std::size_t fec_length = fec_length_;
+
+               int i = -1;
+               std::size_t l = erasure_count;
+
+               // previous_lambda = x * lambda
+               previous_lambda[0] = 0;
+               std::copy(lambda, lambda + fec_length, previous_lambda + 1);
+
+               for (std::size_t round = erasure_count; round < fec_length; ++round)
+               {
+                  const galois::field_symbol discrepancy = compute_discrepancy(lambda, syndrome, l, round);
+
+                  if (0 != discrepancy)
+                  {
+                     if (static_cast<int>(l) < (static_cast<int>(round) - i))
+                     {
+                        const std::size_t tmp = round - i;
+                        i = static_cast<int>(round - l);
+                        l = tmp;
+
+                        for (std::size_t j = 0; j <= fec_length; ++j)
+                        {
+                           const galois::field_symbol t = lambda[j];
+
+                           lambda[j] ^= field_.mul(discrepancy, previous_lambda[j]);
+                           previous_lambda[j] = field_.div(t, discrepancy);
+                        }
+                     }
+                     else
+                     {
+                        for (std::size_t j = 0; j <= fec_length; ++j)
+                        {
+                           lambda[j] ^= field_.mul(discrepancy, previous_lambda[j]);
+                        }
+                     }
+                  }
+
+                  // previous_lambda <<= 1
+                  for (std::size_t j = fec_length; j > 0; --j)
+                  {
+                     previous_lambda[j] = previous_lambda[j - 1];
+                  }
+
+                  previous_lambda[0] = 0;
+               }
             }
 
-            galois::field_polynomial received(field_,code_length - 1);
-            load_message(received,rsblock);
+            void inversionless_berlekamp_massey_algorithm(galois::field_symbol       lambda  [],
+                                                          galois::field_symbol       omega   [],
+                                                          const galois::field_symbol syndrome[],
+                                                          const std::size_t          erasure_count,
+                                                          galois::field_symbol       prev_lam[],
+                                                          galois::field_symbol       prev_omg[]) const
+            {
+               /*
+                  Inversionless Berlekamp-Massey Algorithm (iBM)
+                  Computes the same LFSR as the modified BMA above, on fixed
+                  symbol arrays and without any field divisions. The errata
+                  evaluator (omega) is carried alongside lambda, hence the
+                  discrepancy of each round is simply omega[round] and no
+                  dot product or final (lambda * syndrome) is required.
+                  The resulting lambda and omega are a non-zero scalar
+                  multiple of those produced by the modified BMA, which
+                  leaves their roots and the Forney error magnitudes
+                  unchanged.
+               */
+
+               const std::size_t fec_length = fec_length_;
+
+               compute_omega(lambda, syndrome, omega);
+
+               // prev_lambda = x * lambda, prev_omega = (x * omega) mod x^fec_length
+               prev_lam[0] = 0;
+               prev_omg[0] = 0;
+
+               for (std::size_t i = 1; i <= fec_length; ++i)
+               {
+                  prev_lam[i] = lambda[i - 1];
+               }
+
+               for (std::size_t i = 1; i < fec_length; ++i)
+               {
+                  prev_omg[i] = omega[i - 1];
+               }
+
+               int i = -1;
+               std::size_t l = erasure_count;
+               galois::field_symbol previous_discrepancy = 1;
+
+               for (std::size_t round = erasure_count; round < fec_length; ++round)
+               {
+                  const galois::field_symbol discrepancy = omega[round];
+
+                  if (0 != discrepancy)
+                  {
+                     const bool length_change = (static_cast<int>(l) < (static_cast<int>(round) - i));
+
+                     for (std::size_t j = 0; j <= fec_length; ++j)
+                     {
+                        const galois::field_symbol t = lambda[j];
+
+                        lambda[j] = field_.mul(previous_discrepancy, t) ^ field_.mul(discrepancy, prev_lam[j]);
+
+                        if (length_change) prev_lam[j] = t;
+                     }
+
+                     for (std::size_t j = 0; j < fec_length; ++j)
+                     {
+                        const galois::field_symbol t = omega[j];
+
+                        omega[j] = field_.mul(previous_discrepancy, t) ^ field_.mul(discrepancy, prev_omg[j]);
 
-            galois::field_polynomial syndrome(field_);
+                        if (length_change) prev_omg[j] = t;
+                     }
+
+                     if (length_change)
+                     {
+                        const std::size_t tmp = round - i;
+                        i = static_cast<int>(round - l);
+                        l = tmp;
+                        previous_discrepancy = discrepancy;
+                     }
+                  }
+
+                  for (std::size_t j = fec_length; j > 0; --j)
+                  {
+                     prev_lam[j] = prev_lam[j - 1];
+                  }
+
+                  for (std::size_t j = fec_length - 1; j > 0; --j)
+                  {
+                     prev_omg[j] = prev_omg[j - 1];
+                  }
+
+                  prev_lam[0] = 0;
+                  prev_omg[0] = 0;
+               }
+            }
+
+            bool euclidean_algorithm(galois::field_symbol       lambda  [],
+                                     galois::field_symbol       omega   [],
+                                     const galois::field_symbol syndrome[],
+                                     const std::size_t          erasure_count,
+                                     galois::field_symbol       gam     [],
+                                     galois::field_symbol       r_prev  [],
+                                     galois::field_symbol       r_curr  [],
+                                     galois::field_symbol       t_prev  [],
+                                     galois::field_symbol       t_curr  []) const
+            {
+               /*
+                  Euclidean (Sugiyama) Algorithm
+                  Runs the extended Euclidean algorithm on x^fec_length and the
+                  erasure modified syndrome T(x) = (gamma * syndrome) mod x^fec_length
+                  until 2 * deg(remainder) < fec_length + erasure_count. The
+                  remainder is the errata evaluator (omega) and the accumulated
+                  multiplier of T(x) is the error locator, which multiplied by
+                  gamma yields the errata locator (lambda). Both are obtained
+                  simultaneously, on fixed symbol arrays. Returns false when
+                  the pair found cannot describe a valid errata pattern, that
+                  being when deg(omega) >= deg(lambda).
+               */
+
+               const std::size_t fec_length = fec_length_;
+
+               std::fill_n(r_prev, fec_length + 1, galois::field_symbol(0));
+               std::fill_n(t_prev, fec_length + 1, galois::field_symbol(0));
+               std::fill_n(t_curr, fec_length + 1, galois::field_symbol(0));
+
+               std::copy(lambda, lambda + fec_length + 1, gam);
+
+               const int gamma_degree = degree(gam, fec_length + 1);
+
+               // r_prev = x^fec_length, r_curr = (gamma * syndrome) mod x^fec_length
+               r_prev[fec_length] = 1;
+               r_curr[fec_length] = 0;
+
+               compute_omega(gam, syndrome, r_curr);
+
+               // t_prev = 0, t_curr = 1
+               t_curr[0] = 1;
+
+               int r_prev_degree = static_cast<int>(fec_length);
+               int r_curr_degree = degree(r_curr, fec_length);
+               int t_prev_degree = -1;
+               int t_curr_degree = 0;
+
+               galois::field_symbol* rp = r_prev;
+               galois::field_symbol* rc = r_curr;
+               galois::field_symbol* tp = t_prev;
+               galois::field_symbol* tc = t_curr;
+
+               while (
+                       (r_curr_degree >= 0) &&
+                       ((2 * r_curr_degree) >= static_cast<int>(fec_length + erasure_count))
+                     )
+               {
+                  /*
+                     rp = rp mod rc and tp = tp - quotient * tc, performed one
+                     leading term at a time.
+                  */
+                  const galois::field_symbol lead_inverse = field_.inverse(rc[r_curr_degree]);
+
+                  while (r_prev_degree >= r_curr_degree)
+                  {
+                     const int shift = r_prev_degree - r_curr_degree;
+                     const galois::field_symbol q = field_.mul(rp[r_prev_degree], lead_inverse);
+
+                     for (int i = 0; i <= r_curr_degree; ++i)
+                     {
+                        rp[i + shift] ^= field_.mul(q, rc[i]);
+                     }
+
+                     for (int i = 0; i <= t_curr_degree; ++i)
+                     {
+                        tp[i + shift] ^= field_.mul(q, tc[i]);
+                     }
+
+                     t_prev_degree = std::max(t_prev_degree, t_curr_degree + shift);
+
+                     while ((r_prev_degree >= 0) && (0 == rp[r_prev_degree])) --r_prev_degree;
+                  }
+
+                  std::swap(rp, rc);
+                  std::swap(tp, tc);
+                  std::swap(r_prev_degree, r_curr_degree);
+                  std::swap(t_prev_degree, t_curr_degree);
+               }
+
+               if (
+                    (r_curr_degree < 0) ||
+                    (r_curr_degree >= (t_curr_degree + gamma_degree))
+                  )
+               {
+                  return false;
+               }
+
+               // lambda = gamma * t_curr, omega = r_curr
+               std::fill_n(lambda, fec_length + 1, galois::field_symbol(0));
+
+               for (int i = 0; i <= t_curr_degree; ++i)
+               {
+                  if (0 == tc[i])
+                     continue;
+
+                  for (int j = 0; (j <= gamma_degree) && ((i + j) <= static_cast<int>(fec_length)); ++j)
+                  {
+                     lambda[i + j] ^= field_.mul(tc[i], gam[j]);
+                  }
+               }
 
-            if (compute_syndrome(received,syndrome) == 0)
-            {
-               rsblock.errors_detected  = 0;
-               rsblock.errors_corrected = 0;
-               rsblock.zero_numerators  = 0;
-               rsblock.unrecoverable    = false;
+               std::copy(rc, rc + fec_length, omega);
 
                return true;
             }
 
-            galois::field_polynomial lambda(galois::field_element(field_,1));
-
-            erasure_locations_t erasure_locations;
-
-            if (!erasure_list.empty())
+            static int degree(const galois::field_symbol poly[], const std::size_t size)
             {
-               prepare_erasure_list(erasure_locations, erasure_list);
+               int result = static_cast<int>(size) - 1;
+
+               while ((result >= 0) && (0 == poly[result])) --result;
 
-               compute_gamma(lambda, erasure_locations);
+               return result;
             }
 
-            if (erasure_list.size() < fec_length)
+            void compute_omega(const galois::field_symbol lambda  [],
+                               const galois::field_symbol syndrome[],
+                               galois::field_symbol       omega   []) const
             {
-               modified_berlekamp_massey_algorithm(lambda, syndrome, erasure_list.size());
-            }
+               /*
+                  Errata evaluator: omega = (lambda * syndrome) mod x^fec_length
+               */
+
+               const std::size_t fec_length = fec_length_;
 
-            std::vector<int> error_locations;
+               std::fill_n(omega, fec_length, galois::field_symbol(0));
 
-            find_roots(lambda, error_locations);
+               for (std::size_t i = 0; i < fec_length; ++i)
+               {
+                  if (0 == lambda[i])
+                     continue;
+
+                  for (std::size_t j = i; j < fec_length; ++j)
+                  {
+                     omega[j] ^= field_.mul(lambda[i], syndrome[j - i]);
+                  }
+               }
+            }
 
-            if (0 == error_locations.size())
+            template <typename ErasurePattern, typename Codeword, typename State>
+            bool forney_algorithm(const ErasurePattern&      pattern,
+                                  const galois::field_symbol lambda_scale,
+                                  const galois::field_symbol omega[],
+                                  Codeword&                  codeword,
+                                  State&                     state) const
             {
                /*
-                 Syndrome is non-zero yet no error locations have
-                 been obtained, conclusion:
-                 It is possible that there are MORE errrors in the
-                 message than can be detected and corrected for this
-                 particular code.
+                  The Forney algorithm for an errata locator that is a scalar
+                  multiple (lambda_scale) of the erasure pattern's gamma. The
+                  omega derived from it carries the same scale, which is
+                  removed before applying the precomputed coefficients.
                */
 
-               rsblock.errors_detected  = 0;
-               rsblock.errors_corrected = 0;
-               rsblock.zero_numerators  = 0;
-               rsblock.unrecoverable    = true;
-               rsblock.error            = block_type::e_decoder_error1;
+               const int omega_degree = degree(omega, fec_length_);
+               const int offset       = static_cast<int>(padding_length_) + 1;
+               const galois::field_symbol scale_inverse = field_.inverse(lambda_scale);
 
-               return false;
+               state.errors_corrected = 0;
+               state.zero_numerators  = 0;
+
+               for (std::size_t i = 0; i < pattern.erasure_count; ++i)
+               {
+                  const int                  error_location = pattern.locations[i];
+                  const galois::field_symbol alpha_inverse  = field_.alpha(error_location);
+
+                  galois::field_symbol omega_value = 0;
+
+                  for (int j = omega_degree; j >= 0; --j)
+                  {
+                     omega_value = field_.mul(omega_value, alpha_inverse) ^ omega[j];
+                  }
+
+                  if (0 != omega_value)
+                  {
+                     codeword[error_location - offset] ^= field_.mul(field_.mul(omega_value, scale_inverse), pattern.coefficient[i]);
+                     state.errors_corrected++;
+                  }
+                  else
+                     ++state.zero_numerators;
+               }
+
+               return true;
             }
-            else if (((2 * error_locations.size()) - erasure_list.size()) > fec_length)
+
+            template <typename Codeword, typename State>
+            bool forney_algorithm(const int                  error_locations[],
+                                  const galois::field_symbol odd_sums[],
+                                  const std::size_t          error_count,
+                                  const int                  lambda_degree,
+                                  const galois::field_symbol omega[],
+                                  Codeword&                  codeword,
+                                  State&                     state) const
             {
                /*
-                  Too many errors\erasures! 2E + S <= fec_length
-                   L =  E + S
-                   E =  L - S
-                  2E = 2L - 2S
-                  2E + S = 2L - 2S + S
-                         = 2L - S
-                 Where:
-                  L : Error Locations
-                  E : Errors
-                  S : Erasures
-
+                  The Forney algorithm for computing the error magnitudes.
+                  The denominator lambda'(x) is not evaluated afresh, the
+                  Chien search has already provided x * lambda'(x) for each
+                  root (the odd register sum), hence:
+                  e = x * omega(x) * root_exponent / odd_sum(x)
                */
 
-               rsblock.errors_detected  = error_locations.size();
-               rsblock.errors_corrected = 0;
-               rsblock.zero_numerators  = 0;
-               rsblock.unrecoverable    = true;
-               rsblock.error            = block_type::e_decoder_error2;
+               const int omega_degree = degree(omega, fec_length_);
+               const int offset       = static_cast<int>(padding_length_) + 1;
 
-               return false;
+               state.errors_corrected = 0;
+               state.zero_numerators  = 0;
+
+               for (std::size_t i = 0; i < error_count; ++i)
+               {
+                  const int                  error_location = error_locations[i];
+                  const galois::field_symbol alpha_inverse  = field_.alpha(error_location);
+
+                  galois::field_symbol omega_value = 0;
+
+                  for (int j = omega_degree; j >= 0; --j)
+                  {
+                     omega_value = field_.mul(omega_value, alpha_inverse) ^ omega[j];
+                  }
+
+                  const galois::field_symbol numerator   = field_.mul(omega_value, root_exponent(error_location));
+                  const galois::field_symbol denominator = odd_sums[i];
+
+                  if (0 != numerator)
+                  {
+                     if (0 != denominator)
+                     {
+                        codeword[error_location - offset] ^= field_.div(field_.mul(numerator, alpha_inverse), denominator);
+                        state.errors_corrected++;
+                     }
+                     else
+                     {
+                        state.unrecoverable = true;
+                        state.error         = State::e_decoder_error3;
+                        return false;
+                     }
+                  }
+                  else
+                     ++state.zero_numerators;
+               }
+
+               if (lambda_degree == static_cast<int>(state.errors_detected))
+                  return true;
+               else
+               {
+                  state.unrecoverable = true;
+                  state.error         = State::e_decoder_error4;
+                  return false;
+               }
             }
-            else
-               rsblock.errors_detected  = error_locations.size();
 
-            return forney_algorithm(error_locations, lambda, syndrome, rsblock);
-         }
+            const galois::field&              field_;
+            const std::size_t                 code_length_;
+            const std::size_t                 fec_length_;
+            const std::size_t                 padding_length_;
+            const unsigned int                gen_initial_index_;
+            const key_equation_solver::type   solver_;
+            const bool                        valid_;
+            const std::size_t                 root_exponent_step_;
+            std::vector<galois::field_symbol> syndrome_exponent_table_;
+            const galois::region_multiplier   multiplier_;
+            remainder_kernel                  syndrome_kernel_;
+            const chien_kernel                chien_kernel_;
+         };
 
-      private:
+      } // namespace details
 
-         decoder();
-         decoder(const decoder& dec);
-         decoder& operator=(const decoder& dec);
+      template <std::size_t code_length, std::size_t fec_length, std::size_t data_length = code_length - fec_length>
+      class decoder
+      {
+      public:
 
-      protected:
+         typedef traits::reed_solomon_triat<code_length,fec_length,data_length> trait;
+         typedef block<code_length,fec_length> block_type;
 
-         void load_message(galois::field_polynomial& received, const block_type& rsblock) const
+         struct erasure_pattern
          {
             /*
-              Load message data into received polynomial in reverse order.
+              Everything about an erasure set that is independent of the
+              block contents: the erasure locator (gamma), its roots in
+              Chien search order, and per root the Forney coefficient
+              x * root_exponent / (x * gamma'(x)), so that the erasure
+              magnitudes reduce to omega(x) * coefficient.
             */
+            std::size_t          erasure_count;
+            std::size_t          erasures   [fec_length    ];
+            galois::field_symbol gamma      [fec_length + 1];
+            int                  locations  [fec_length    ];
+            galois::field_symbol coefficient[fec_length    ];
+            bool                 valid;
+            std::size_t          last_used;
+         };
 
-            for (std::size_t i = 0; i < code_length; ++i)
-            {
-               received[code_length - 1 - i] = rsblock[i];
-            }
+         enum { erasure_cache_size = details::decoder_core::erasure_cache_size };
+
+         struct workspace
+         {
+            /*
+              Scratch space for a single decode. Owned by the caller
+              and reused across calls (one per thread), so that the
+              decoding hot path performs no heap allocations. It also
+              holds a small LRU cache of erasure patterns, keyed by the
+              sorted erasure set, as the same loss pattern is commonly
+              applied to many consecutive blocks. The cache is flushed
+              whenever the workspace is passed to a decoder of another
+              code (eg: another generator initial index).
+            */
+
+            workspace()
+            : erasure_cache_entries(0),
+              erasure_cache_clock(0)
+            {}
+
+            typedef decoder::erasure_pattern erasure_pattern;
+
+            galois::field_symbol syndrome       [fec_length    ];
+            galois::field_symbol lambda         [fec_length + 1];
+            galois::field_symbol omega          [fec_length    ];
+            int                  error_locations[fec_length    ];
+            galois::field_symbol odd_sums       [fec_length    ];
+            std::size_t          erasure_key    [fec_length    ];
+            galois::field_symbol scratch     [5][fec_length + 1];
+            erasure_pattern      erasure_cache  [erasure_cache_size];
+            std::size_t          erasure_cache_entries;
+            std::size_t          erasure_cache_clock;
+
+            details::erasure_cache_owner erasure_cache_owner;
+         };
+
+         decoder(const galois::field& field,
+                 const unsigned int& gen_initial_index = 0,
+                 const key_equation_solver::type solver = key_equation_solver::berlekamp_massey)
+         : decoder_valid_(field.size() == code_length),
+           field_(field),
+           core_(field, code_length, fec_length, gen_initial_index, solver)
+         {}
+
+         const galois::field& field() const
+         {
+            return field_;
          }
 
-         void create_lookup_tables()
+         key_equation_solver::type solver() const
          {
-            root_exponent_table_.reserve(field_.size() + 1);
+            return core_.solver();
+         }
 
-            for (int i = 0; i < static_cast<int>(field_.size() + 1); ++i)
-            {
-               root_exponent_table_.push_back(field_.exp(field_.alpha(code_length - i),(1 - gen_initial_index_)));
-            }
+         /*
+           Blocks are decoded in place, whatever their symbol storage type
+           (see block), as are the block views (contiguous, strided and
+           segmented) over caller owned memory.
+         */
 
-            syndrome_exponent_table_.reserve(fec_length);
+         template <typename T>
+         bool decode(block<code_length,fec_length,data_length,T>& rsblock) const
+         {
+            workspace ws;
+            return decode_codeword(rsblock, empty_erasure_list(), ws);
+         }
 
-            for (int i = 0; i < static_cast<int>(fec_length); ++i)
-            {
-               syndrome_exponent_table_.push_back(field_.alpha(gen_initial_index_ + i));
-            }
+         template <typename T>
+         bool decode(block<code_length,fec_length,data_length,T>& rsblock, const erasure_locations_t& erasure_list) const
+         {
+            workspace ws;
+            return decode_codeword(rsblock, erasure_list, ws);
+         }
 
-            gamma_table_.reserve(field_.size() + 1);
+         template <typename T>
+         bool decode(block<code_length,fec_length,data_length,T>& rsblock, workspace& ws) const
+         {
+            return decode_codeword(rsblock, empty_erasure_list(), ws);
+         }
 
-            for (int i = 0; i < static_cast<int>(field_.size() + 1); ++i)
-            {
-               gamma_table_.push_back((1 + (X_ * galois::field_element(field_,field_.alpha(i)))));
-            }
+         template <typename T>
+         bool decode(block<code_length,fec_length,data_length,T>& rsblock, const erasure_locations_t& erasure_list, workspace& ws) const
+         {
+            return decode_codeword(rsblock, erasure_list, ws);
          }
 
-         void prepare_erasure_list(erasure_locations_t& erasure_locations, const erasure_locations_t& erasure_list) const
+         template <typename T>
+         bool decode(block_view<code_length,fec_length,T>& rsblock) const
          {
-            /*
-              Note: 1. Erasure positions must be unique.
-                    2. Erasure positions must exist within the code block.
-                    There are NO exceptions to these rules!
-            */
+            workspace ws;
+            return decode_codeword(rsblock, empty_erasure_list(), ws);
+         }
 
-            erasure_locations.resize(erasure_list.size());
+         template <typename T>
+         bool decode(block_view<code_length,fec_length,T>& rsblock, const erasure_locations_t& erasure_list) const
+         {
+            workspace ws;
+            return decode_codeword(rsblock, erasure_list, ws);
+         }
 
-            for (std::size_t i = 0; i < erasure_list.size(); ++i)
-            {
-               erasure_locations[i] = (code_length - 1 - erasure_list[i]);
-            }
+         template <typename T>
+         bool decode(block_view<code_length,fec_length,T>& rsblock, workspace& ws) const
+         {
+            return decode_codeword(rsblock, empty_erasure_list(), ws);
          }
 
-         int compute_syndrome(const galois::field_polynomial& received,
-                                    galois::field_polynomial& syndrome) const
+         template <typename T>
+         bool decode(block_view<code_length,fec_length,T>& rsblock, const erasure_locations_t& erasure_list, workspace& ws) const
          {
-            int error_flag = 0;
-            syndrome = galois::field_polynomial(field_,fec_length - 1);
+            return decode_codeword(rsblock, erasure_list, ws);
+         }
 
-            for (std::size_t i = 0; i < fec_length; ++i)
-            {
-               syndrome[i]  = received(syndrome_exponent_table_[i]);
-               error_flag  |= syndrome[i].poly();
-            }
+         template <typename T>
+         bool decode(strided_block_view<code_length,fec_length,T>& rsblock) const
+         {
+            workspace ws;
+            return decode_codeword(rsblock, empty_erasure_list(), ws);
+         }
 
-            return error_flag;
+         template <typename T>
+         bool decode(strided_block_view<code_length,fec_length,T>& rsblock, const erasure_locations_t& erasure_list) const
+         {
+            workspace ws;
+            return decode_codeword(rsblock, erasure_list, ws);
          }
 
-         void compute_gamma(galois::field_polynomial& gamma, const erasure_locations_t& erasure_locations) const
+         template <typename T>
+         bool decode(strided_block_view<code_length,fec_length,T>& rsblock, workspace& ws) const
          {
-            for (std::size_t i = 0; i < erasure_locations.size(); ++i)
-            {
-               gamma *= gamma_table_[erasure_locations[i]];
-            }
+            return decode_codeword(rsblock, empty_erasure_list(), ws);
          }
 
-         void find_roots(const galois::field_polynomial& poly, std::vector<int>& root_list) const
+         template <typename T>
+         bool decode(strided_block_view<code_length,fec_length,T>& rsblock, const erasure_locations_t& erasure_list, workspace& ws) const
          {
-            /*
-               Chien Search: Find the roots of the error locator polynomial
-               via an exhaustive search over all non-zero elements in the
-               given finite field.
-            */
+            return decode_codeword(rsblock, erasure_list, ws);
+         }
+
+         template <typename T>
+         bool decode(block_column_view<code_length,fec_length,T>& rsblock) const
+         {
+            workspace ws;
+            return decode_codeword(rsblock, empty_erasure_list(), ws);
+         }
+
+         template <typename T>
+         bool decode(block_column_view<code_length,fec_length,T>& rsblock, const erasure_locations_t& erasure_list) const
+         {
+            workspace ws;
+            return decode_codeword(rsblock, erasure_list, ws);
+         }
 
-            root_list.reserve(fec_length << 1);
-            root_list.resize(0);
+         template <typename T>
+         bool decode(block_column_view<code_length,fec_length,T>& rsblock, workspace& ws) const
+         {
+            return decode_codeword(rsblock, empty_erasure_list(), ws);
+         }
 
-            const std::size_t polynomial_degree = poly.deg();
+         template <typename T>
+         bool decode(block_column_view<code_length,fec_length,T>& rsblock, const erasure_locations_t& erasure_list, workspace& ws) const
+         {
+            return decode_codeword(rsblock, erasure_list, ws);
+         }
 
-            for (int i = 1; i <= static_cast<int>(code_length); ++i)
-            {
-               if (0 == poly(field_.alpha(i)).poly())
-               {
-                  root_list.push_back(i);
+         template <typename T>
+         bool decode(segmented_block_view<code_length,fec_length,T>& rsblock) const
+         {
+            workspace ws;
+            return decode_codeword(rsblock, empty_erasure_list(), ws);
+         }
 
-                  if (polynomial_degree == root_list.size())
-                  {
-                     break;
-                  }
-               }
-            }
+         template <typename T>
+         bool decode(segmented_block_view<code_length,fec_length,T>& rsblock, const erasure_locations_t& erasure_list) const
+         {
+            workspace ws;
+            return decode_codeword(rsblock, erasure_list, ws);
          }
 
-         void compute_discrepancy(galois::field_element&          discrepancy,
-                                  const galois::field_polynomial& lambda,
-                                  const galois::field_polynomial& syndrome,
-                                  const std::size_t&              l,
-                                  const std::size_t&              round) const
+         template <typename T>
+         bool decode(segmented_block_view<code_length,fec_length,T>& rsblock, workspace& ws) const
          {
-            /*
-               Compute the lambda discrepancy at the current round of BMA
-            */
+            return decode_codeword(rsblock, empty_erasure_list(), ws);
+         }
 
-            const std::size_t upper_bound = std::min(static_cast<int>(l), lambda.deg());
+         template <typename T>
+         bool decode(segmented_block_view<code_length,fec_length,T>& rsblock, const erasure_locations_t& erasure_list, workspace& ws) const
+         {
+            return decode_codeword(rsblock, erasure_list, ws);
+         }
 
-            discrepancy = 0;
+         template <typename Permutation, typename T>
+         bool decode(permuted_block_view<code_length,fec_length,Permutation,T>& rsblock) const
+         {
+            workspace ws;
+            return decode_codeword(rsblock, empty_erasure_list(), ws);
+         }
 
-            for (std::size_t i = 0; i <= upper_bound; ++i)
-            {
-               discrepancy += lambda[i] * syndrome[round - i];
-            }
+         template <typename Permutation, typename T>
+         bool decode(permuted_block_view<code_length,fec_length,Permutation,T>& rsblock, const erasure_locations_t& erasure_list) const
+         {
+            workspace ws;
+            return decode_codeword(rsblock, erasure_list, ws);
+         }
+
+         template <typename Permutation, typename T>
+         bool decode(permuted_block_view<code_length,fec_length,Permutation,T>& rsblock, workspace& ws) const
+         {
+            return decode_codeword(rsblock, empty_erasure_list(), ws);
+         }
+
+         template <typename Permutation, typename T>
+         bool decode(permuted_block_view<code_length,fec_length,Permutation,T>& rsblock, const erasure_locations_t& erasure_list, workspace& ws) const
+         {
+            return decode_codeword(rsblock, erasure_list, ws);
+         }
+
+         bool decode_batch(block_type*                rsblocks,
+                           const std::size_t          count,
+                           const erasure_locations_t* erasure_lists,
+                           batch_result&              result) const
+         {
+            workspace ws;
+            return decode_batch(rsblocks, count, erasure_lists, result, ws);
          }
 
-         void modified_berlekamp_massey_algorithm(galois::field_polynomial&       lambda,
-                                                  const galois::field_polynomial& syndrome,
-                                                  const std::size_t               erasure_count) const
+         bool decode_batch(block_type*                rsblocks,
+                           const std::size_t          count,
+                           const erasure_locations_t* erasure_lists,
+                           batch_result&              result,
+                           workspace&                 ws) const
          {
             /*
-               Modified Berlekamp-Massey Algorithm
-               Identify the shortest length linear feed-back shift register (LFSR)
-               that will generate the sequence equivalent to the syndrome.
+              Decode count consecutive blocks one after the other, with
+              the one workspace, the results being the same as those of
+              as many decode calls. erasure_lists is either null (no
+              erasures) or points to count erasure lists, one per block.
+              The result holds the aggregate counters for this batch only.
+              Returns true when every block in the batch was successfully
+              decoded.
             */
 
-            int i = -1;
-            std::size_t l = erasure_count;
+            result.clear();
 
-            galois::field_element discrepancy(field_,0);
-            galois::field_polynomial previous_lambda = lambda << 1;
-
-            for (std::size_t round = erasure_count; round < fec_length; ++round)
+            for (std::size_t i = 0; i < count; ++i)
             {
-               compute_discrepancy(discrepancy, lambda, syndrome, l, round);
+               block_type& rsblock = rsblocks[i];
 
-               if (discrepancy != 0)
-               {
-                  galois::field_polynomial tau = lambda - (discrepancy * previous_lambda);
+               const bool decoded = decode(rsblock, (erasure_lists ? erasure_lists[i] : empty_erasure_list()), ws);
 
-                  if (static_cast<int>(l) < (static_cast<int>(round) - i))
-                  {
-                     const std::size_t tmp = round - i;
-                     i = static_cast<int>(round - l);
-                     l = tmp;
-                     previous_lambda = lambda / discrepancy;
-                  }
+               result.update(decoded, rsblock.errors_detected, rsblock.errors_corrected);
+            }
 
-                  lambda = tau;
-               }
+            return (0 == result.failed);
+         }
 
-               previous_lambda <<= 1;
-            }
+         bool decode_batch(block_type*                rsblocks,
+                           const std::size_t          count,
+                           const erasure_locations_t& erasure_list,
+                           batch_result&              result) const
+         {
+            workspace ws;
+            return decode_batch(rsblocks, count, erasure_list, result, ws);
          }
 
-         bool forney_algorithm(const std::vector<int>&         error_locations,
-                               const galois::field_polynomial& lambda,
-                               const galois::field_polynomial& syndrome,
-                               block_type&                     rsblock) const
+         bool decode_batch(block_type*                rsblocks,
+                           const std::size_t          count,
+                           const erasure_locations_t& erasure_list,
+                           batch_result&              result,
+                           workspace&                 ws) const
          {
             /*
-               The Forney algorithm for computing the error magnitudes
+              Decode count consecutive blocks, one after the other, that
+              all share the one erasure list (eg: the columns of an
+              erasure channel stack). The erasure pattern is computed for
+              the first block, the others being served it by the
+              workspace's erasure cache - as would as many decode calls.
             */
-            const galois::field_polynomial omega = (lambda * syndrome) % fec_length;
-            const galois::field_polynomial lambda_derivative = lambda.derivative();
 
-            rsblock.errors_corrected = 0;
-            rsblock.zero_numerators  = 0;
+            result.clear();
 
-            for (std::size_t i = 0; i < error_locations.size(); ++i)
+            for (std::size_t i = 0; i < count; ++i)
             {
-               const unsigned int         error_location = error_locations[i];
-               const galois::field_symbol alpha_inverse  = field_.alpha(error_location);
-               const galois::field_symbol numerator      = (omega(alpha_inverse) * root_exponent_table_[error_location]).poly();
-               const galois::field_symbol denominator    = lambda_derivative(alpha_inverse).poly();
+               block_type& rsblock = rsblocks[i];
 
-               if (0 != numerator)
-               {
-                  if (0 != denominator)
-                  {
-                     rsblock[error_location - 1] ^= field_.div(numerator, denominator);
-                     rsblock.errors_corrected++;
-                  }
-                  else
-                  {
-                     rsblock.unrecoverable = true;
-                     rsblock.error         = block_type::e_decoder_error3;
-                     return false;
-                  }
-               }
-               else
-                  ++rsblock.zero_numerators;
+               const bool decoded = decode(rsblock, erasure_list, ws);
+
+               result.update(decoded, rsblock.errors_detected, rsblock.errors_corrected);
             }
 
-            if (lambda.deg() == static_cast<int>(rsblock.errors_detected))
-               return true;
-            else
+            return (0 == result.failed);
+         }
+
+      private:
+
+         decoder();
+         decoder(const decoder& dec);
+         decoder& operator=(const decoder& dec);
+
+         template <typename BlockType>
+         bool decode_codeword(BlockType& rsblock, const erasure_locations_t& erasure_list, workspace& ws) const
+         {
+            if (!decoder_valid_)
             {
-               rsblock.unrecoverable = true;
-               rsblock.error         = block_type::e_decoder_error4;
+               rsblock.errors_detected  = 0;
+               rsblock.errors_corrected = 0;
+               rsblock.zero_numerators  = 0;
+               rsblock.unrecoverable    = true;
+               rsblock.error            = block_state::e_decoder_error0;
+
                return false;
             }
+
+            return core_.decode(rsblock, rsblock, erasure_list, ws);
          }
 
       protected:
 
-         bool                                  decoder_valid_;
-         const galois::field&                  field_;
-         std::vector<galois::field_symbol>     root_exponent_table_;
-         std::vector<galois::field_symbol>     syndrome_exponent_table_;
-         std::vector<galois::field_polynomial> gamma_table_;
-         const galois::field_polynomial        X_;
-         const unsigned int                    gen_initial_index_;
+         bool                        decoder_valid_;
+         const galois::field&        field_;
+         const details::decoder_core core_;
       };
 
       template <std::size_t code_length,
@@ -404,49 +1525,118 @@ namespace schifra
 
          typedef traits::reed_solomon_triat<code_length,fec_length,data_length> trait;
          typedef block<code_length,fec_length> block_type;
+         typedef decoder<natural_length,fec_length> natural_decoder_type;
+
+         struct workspace
+         {
+            workspace()
+            {
+               shifted_erasure_list.reserve(fec_length);
+            }
+
+            typename natural_decoder_type::workspace  natural;
+            typename natural_decoder_type::block_type block;
+            erasure_locations_t                       shifted_erasure_list;
+         };
 
-         shortened_decoder(const galois::field& field, const unsigned int gen_initial_index = 0)
-         : decoder_(field, gen_initial_index)
+         shortened_decoder(const galois::field& field,
+                           const unsigned int gen_initial_index = 0,
+                           const key_equation_solver::type solver = key_equation_solver::berlekamp_massey)
+         : decoder_(field, gen_initial_index, solver)
          {}
 
          inline bool decode(block_type& rsblock, const erasure_locations_t& erasure_list) const
          {
-            typename natural_decoder_type::block_type block;
-
-            std::fill_n(&block[0], padding_length, typename block_type::symbol_type(0));
+            workspace ws;
+            return decode(rsblock, erasure_list, ws);
+         }
 
-            for (std::size_t i = 0; i < code_length; ++i)
-            {
-               block.data[padding_length + i] = rsblock.data[i];
-            }
+         inline bool decode(block_type& rsblock) const
+         {
+            workspace ws;
+            return decode(rsblock, ws);
+         }
 
-            erasure_locations_t shifted_position_erasure_list(erasure_list.size(),0);
+         inline bool decode(block_type& rsblock, const erasure_locations_t& erasure_list, workspace& ws) const
+         {
+            ws.shifted_erasure_list.resize(erasure_list.size());
 
             for (std::size_t i = 0; i < erasure_list.size(); ++i)
             {
-               shifted_position_erasure_list[i] = erasure_list[i] + padding_length;
+               ws.shifted_erasure_list[i] = erasure_list[i] + padding_length;
             }
 
-            if (decoder_.decode(block, shifted_position_erasure_list))
+            return decode_natural(rsblock, ws.shifted_erasure_list, ws);
+         }
+
+         inline bool decode(block_type& rsblock, workspace& ws) const
+         {
+            ws.shifted_erasure_list.clear();
+
+            return decode_natural(rsblock, ws.shifted_erasure_list, ws);
+         }
+
+         inline bool decode_batch(block_type*                rsblocks,
+                                  const std::size_t          count,
+                                  const erasure_locations_t* erasure_lists,
+                                  batch_result&              result) const
+         {
+            workspace ws;
+            return decode_batch(rsblocks, count, erasure_lists, result, ws);
+         }
+
+         inline bool decode_batch(block_type*                rsblocks,
+                                  const std::size_t          count,
+                                  const erasure_locations_t* erasure_lists,
+                                  batch_result&              result,
+                                  workspace&                 ws) const
+         {
+            result.clear();
+
+            for (std::size_t i = 0; i < count; ++i)
             {
-               for (std::size_t i = 0; i < code_length; ++i)
-               {
-                  rsblock.data[i] = block.data[padding_length + i];
-               }
+               block_type& rsblock = rsblocks[i];
 
-               rsblock.copy_state(block);
-               return true;
+               const bool decoded = (erasure_lists ? decode(rsblock, erasure_lists[i], ws) : decode(rsblock, ws));
+
+               result.update(decoded, rsblock.errors_detected, rsblock.errors_corrected);
             }
-            else
+
+            return (0 == result.failed);
+         }
+
+         inline bool decode_batch(block_type*                rsblocks,
+                                  const std::size_t          count,
+                                  const erasure_locations_t& erasure_list,
+                                  batch_result&              result) const
+         {
+            workspace ws;
+            return decode_batch(rsblocks, count, erasure_list, result, ws);
+         }
+
+         inline bool decode_batch(block_type*                rsblocks,
+                                  const std::size_t          count,
+                                  const erasure_locations_t& erasure_list,
+                                  batch_result&              result,
+                                  workspace&                 ws) const
+         {
+            result.clear();
+
+            for (std::size_t i = 0; i < count; ++i)
             {
-               rsblock.copy_state(block);
-               return false;
+               block_type& rsblock = rsblocks[i];
+
+               result.update(decode(rsblock, erasure_list, ws), rsblock.errors_detected, rsblock.errors_corrected);
             }
+
+            return (0 == result.failed);
          }
 
-         inline bool decode(block_type& rsblock) const
+      private:
+
+         inline bool decode_natural(block_type& rsblock, const erasure_locations_t& erasure_list, workspace& ws) const
          {
-            typename natural_decoder_type::block_type block;
+            typename natural_decoder_type::block_type& block = ws.block;
 
             std::fill_n(&block[0], padding_length, typename block_type::symbol_type(0));
 
@@ -455,7 +1645,7 @@ namespace schifra
                block.data[padding_length + i] = rsblock.data[i];
             }
 
-            if (decoder_.decode(block))
+            if (decoder_.decode(block, erasure_list, ws.natural))
             {
                for (std::size_t i = 0; i < code_length; ++i)
                {
@@ -472,9 +1662,6 @@ namespace schifra
             }
          }
 
-      private:
-
-         typedef decoder<natural_length,fec_length> natural_decoder_type;
          const natural_decoder_type decoder_;
       };
 
@@ -24,12 +24,16 @@
 #define INCLUDE_SCHIFRA_REED_SOLOMON_ENCODER_HPP
 
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "schifra_galois_field.hpp"
 #include "schifra_galois_field_element.hpp"
 #include "schifra_galois_field_polynomial.hpp"
+#include "schifra_galois_field_region.hpp"
 #include "schifra_reed_solomon_block.hpp"
+#include "schifra_reed_solomon_kernels.hpp"
 #include "schifra_ecc_traits.hpp"
 
 
@@ -39,6 +43,221 @@ namespace schifra
    namespace reed_solomon
    {
 
+      namespace details
+      {
+         class encoder_core
+         {
+         public:
+
+            /*
+              The systematic encoder for a code whose parameters are only
+              known at runtime. The parities are the remainder of the
+              message * x^fec_length divided by the generator, computed by
+              the usual LFSR: one feedback symbol per data symbol, taken
+              from the highest order data symbol (data[0]) downwards.
+              Shortened codes need no padding, as leading zero symbols do
+              not alter the LFSR state. Fields of up to 2^8 elements have
+              the LFSR bound to the vectorised kernel of the active cpu
+              level (see remainder_kernel).
+            */
+
+            encoder_core(const galois::field&            field,
+                         const std::size_t               code_length,
+                         const std::size_t               fec_length,
+                         const galois::field_polynomial& generator)
+            : field_(field),
+              code_length_(code_length),
+              fec_length_(fec_length),
+              data_length_(code_length - fec_length),
+              valid_(
+                      (0 < fec_length)                                    &&
+                      (fec_length < code_length)                          &&
+                      (code_length <= field.size())                       &&
+                      (static_cast<int>(fec_length) == generator.deg())  &&
+                      (0 != generator[fec_length].poly())
+                    ),
+              feedback_table_(make_feedback_table(field, fec_length, generator, valid_)),
+              multiplier_(field),
+              remainder_kernel_(multiplier_, (valid_ ? fec_length : 0), data_length_, &feedback_table_[0])
+            {}
+
+            inline bool valid() const
+            {
+               return valid_;
+            }
+
+            template <typename Codeword>
+            inline void encode(Codeword& codeword) const
+            {
+               if (remainder_kernel_.valid())
+               {
+                  unsigned char parity[remainder_kernel::max_fec_length];
+
+                  remainder_kernel_.compute(codeword, parity);
+
+                  for (std::size_t k = 0; k < fec_length_; ++k)
+                  {
+                     codeword[data_length_ + k] = parity[k];
+                  }
+
+                  return;
+               }
+
+               switch (fec_length_)
+               {
+                  case   2 : encode_kernel<  2>(codeword); break;
+                  case   4 : encode_kernel<  4>(codeword); break;
+                  case   6 : encode_kernel<  6>(codeword); break;
+                  case   8 : encode_kernel<  8>(codeword); break;
+                  case  10 : encode_kernel< 10>(codeword); break;
+                  case  12 : encode_kernel< 12>(codeword); break;
+                  case  16 : encode_kernel< 16>(codeword); break;
+                  case  20 : encode_kernel< 20>(codeword); break;
+                  case  24 : encode_kernel< 24>(codeword); break;
+                  case  32 : encode_kernel< 32>(codeword); break;
+                  case  64 : encode_kernel< 64>(codeword); break;
+                  default  : encode_kernel<  0>(codeword); break;
+               }
+            }
+
+         private:
+
+            /*
+              Registers of up to 256 symbols (the longest fec length of a
+              code over a field of up to 2^8 elements) may be local arrays.
+            */
+            enum { max_register_length = 256 };
+
+            encoder_core(const encoder_core&);
+            encoder_core& operator=(const encoder_core&);
+
+            static std::vector<galois::field_symbol> make_feedback_table(const galois::field&            field,
+                                                                         const std::size_t               fec_length,
+                                                                         const galois::field_polynomial& generator,
+                                                                         const bool                      valid)
+            {
+               /*
+                 feedback_table[k] = g[fec_length - 1 - k] / g[fec_length],
+                 the remainder is unaffected by making the generator monic.
+               */
+
+               std::vector<galois::field_symbol> feedback_table(1, 0);
+
+               if (valid)
+               {
+                  feedback_table.resize(fec_length);
+
+                  const galois::field_symbol lead = generator[fec_length].poly();
+
+                  for (std::size_t k = 0; k < fec_length; ++k)
+                  {
+                     feedback_table[k] = field.div(generator[fec_length - 1 - k].poly(), lead);
+                  }
+               }
+
+               return feedback_table;
+            }
+
+            template <std::size_t fixed_fec_length, typename Codeword>
+            inline void encode_kernel(Codeword& codeword) const
+            {
+               /*
+                 Kernels specialised upon the common fec lengths have their
+                 register in a fixed size local array (fixed_fec_length > 0),
+                 all others run the register in the codeword's fec symbols -
+                 unless these are narrower than a field symbol or are not
+                 contiguous (eg: a strided view), in which case the register
+                 is a local array of max_register_length symbols. Should the
+                 fec length exceed even that (only possible over fields of
+                 more than 2^8 elements), the register is run through the
+                 codeword's own subscript operator. reg[k] holds the
+                 coefficient of x^(fec_length - 1 - k), which is the very
+                 order of the codeword's fec symbols.
+               */
+
+               const std::size_t fec_length = (fixed_fec_length ? fixed_fec_length : fec_length_);
+
+               galois::field_symbol  local_reg[fixed_fec_length ? fixed_fec_length : std::size_t(max_register_length)];
+               galois::field_symbol* reg = (fixed_fec_length ? local_reg : in_place_register(codeword));
+
+               if (0 != reg)
+                  lfsr(codeword, reg, 0, fec_length);
+               else if (fec_length <= max_register_length)
+                  lfsr(codeword, (reg = local_reg), 0, fec_length);
+               else
+                  lfsr(codeword, codeword, data_length_, fec_length);
+
+               if (reg == local_reg)
+               {
+                  for (std::size_t k = 0; k < fec_length_; ++k)
+                  {
+                     codeword[data_length_ + k] = reg[k];
+                  }
+               }
+            }
+
+            template <typename Codeword, typename Register>
+            inline void lfsr(Codeword& codeword, Register& reg, const std::size_t offset, const std::size_t fec_length) const
+            {
+               /*
+                 The register being reg[offset .. offset + fec_length - 1]
+               */
+
+               const galois::field_symbol* feedback_table = &feedback_table_[0];
+
+               for (std::size_t k = 0; k < fec_length; ++k)
+               {
+                  reg[offset + k] = 0;
+               }
+
+               for (std::size_t i = 0; i < data_length_; ++i)
+               {
+                  const galois::field_symbol feedback = codeword[i] ^ reg[offset];
+
+                  for (std::size_t k = 0; k < (fec_length - 1); ++k)
+                  {
+                     reg[offset + k] = reg[offset + k + 1] ^ field_.mul(feedback, feedback_table[k]);
+                  }
+
+                  reg[offset + fec_length - 1] = field_.mul(feedback, feedback_table[fec_length - 1]);
+               }
+            }
+
+            inline galois::field_symbol* in_place_register(galois::field_symbol* codeword) const
+            {
+               return codeword + data_length_;
+            }
+
+            template <std::size_t n, std::size_t f, std::size_t d>
+            inline galois::field_symbol* in_place_register(block<n,f,d,galois::field_symbol>& codeword) const
+            {
+               return &codeword[data_length_];
+            }
+
+            template <std::size_t n, std::size_t f>
+            inline galois::field_symbol* in_place_register(block_view<n,f,galois::field_symbol>& codeword) const
+            {
+               return &codeword[data_length_];
+            }
+
+            template <typename Codeword>
+            inline galois::field_symbol* in_place_register(Codeword&) const
+            {
+               return 0;
+            }
+
+            const galois::field&              field_;
+            const std::size_t                 code_length_;
+            const std::size_t                 fec_length_;
+            const std::size_t                 data_length_;
+            const bool                        valid_;
+            std::vector<galois::field_symbol> feedback_table_;
+            const galois::region_multiplier   multiplier_;
+            const remainder_kernel            remainder_kernel_;
+         };
+
+      } // namespace details
+
       template <std::size_t code_length, std::size_t fec_length, std::size_t data_length = code_length - fec_length>
       class encoder
       {
@@ -50,7 +269,7 @@ namespace schifra
          encoder(const galois::field& gfield, const galois::field_polynomial& generator)
          : encoder_valid_(code_length == gfield.size()),
            field_(gfield),
-           generator_(generator)
+           core_(gfield, code_length, fec_length, generator)
          {}
 
         ~encoder()
@@ -58,36 +277,44 @@ namespace schifra
 
          inline bool encode(block_type& rsblock) const
          {
-            if (!encoder_valid_)
-            {
-               rsblock.error = block_type::e_encoder_error0;
-               return false;
-            }
+            return encode_codeword(rsblock);
+         }
 
-            const galois::field_polynomial parities = msg_poly(rsblock) % generator_;
-            const galois::field_symbol     mask     = field_.mask();
+         template <typename T>
+         inline bool encode(block<code_length,fec_length,data_length,T>& rsblock) const
+         {
+            return encode_codeword(rsblock);
+         }
 
-            if (parities.deg() == (fec_length - 1))
-            {
-               for (std::size_t i = 0; i < fec_length; ++i)
-               {
-                  rsblock.fec(i) = parities[fec_length - 1 - i].poly() & mask;
-               }
-            }
-            else
-            {
-               /*
-                  Note: Encoder should never branch here.
-                  Possible issues to look for:
-                  1. Generator polynomial degree is not equivelent to fec length
-                  2. Field and code length are not consistent.
+         template <typename T>
+         inline bool encode(block_view<code_length,fec_length,T>& rsblock) const
+         {
+            // The fec symbols are written straight into the viewed memory
+            return encode_codeword(rsblock);
+         }
 
-               */
-               rsblock.error = block_type::e_encoder_error1;
-               return false;
-            }
+         template <typename T>
+         inline bool encode(strided_block_view<code_length,fec_length,T>& rsblock) const
+         {
+            return encode_codeword(rsblock);
+         }
 
-            return true;
+         template <typename T>
+         inline bool encode(block_column_view<code_length,fec_length,T>& rsblock) const
+         {
+            return encode_codeword(rsblock);
+         }
+
+         template <typename T>
+         inline bool encode(segmented_block_view<code_length,fec_length,T>& rsblock) const
+         {
+            return encode_codeword(rsblock);
+         }
+
+         template <typename Permutation, typename T>
+         inline bool encode(permuted_block_view<code_length,fec_length,Permutation,T>& rsblock) const
+         {
+            return encode_codeword(rsblock);
          }
 
          inline bool encode(const std::string& data, block_type& rsblock) const
@@ -109,21 +336,36 @@ namespace schifra
          encoder(const encoder& enc);
          encoder& operator=(const encoder& enc);
 
-         inline galois::field_polynomial msg_poly(const block_type& rsblock) const
+         template <typename BlockType>
+         inline bool encode_codeword(BlockType& rsblock) const
          {
-            galois::field_polynomial message(field_, code_length);
+            if (!encoder_valid_)
+            {
+               rsblock.error = block_state::e_encoder_error0;
+               return false;
+            }
 
-            for (std::size_t i = fec_length; i < code_length; ++i)
+            if (!core_.valid())
             {
-               message[i] = rsblock.data[code_length - 1 - i];
+               /*
+                  Note: Encoder should never branch here.
+                  Possible issues to look for:
+                  1. Generator polynomial degree is not equivelent to fec length
+                  2. Field and code length are not consistent.
+
+               */
+               rsblock.error = block_state::e_encoder_error1;
+               return false;
             }
 
-            return message;
+            core_.encode(rsblock);
+
+            return true;
          }
 
-         const bool                     encoder_valid_;
-         const galois::field&           field_;
-         const galois::field_polynomial generator_;
+         const bool                  encoder_valid_;
+         const galois::field&        field_;
+         const details::encoder_core core_;
       };
 
       template <std::size_t code_length,
@@ -176,7 +418,7 @@ namespace schifra
 
             for (std::size_t i = 0; i < data_length; ++i)
             {
-               block.data[padding_length + i] = data[i];
+               block.data[padding_length + i] = static_cast<typename block_type::symbol_type>(static_cast<unsigned char>(data[i]));
             }
 
             if (encoder_.encode(block))
@@ -0,0 +1,378 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+#ifndef INCLUDE_SCHIFRA_REED_SOLOMON_ERASURE_RECOVERY_HPP
+#define INCLUDE_SCHIFRA_REED_SOLOMON_ERASURE_RECOVERY_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "schifra_galois_field.hpp"
+#include "schifra_reed_solomon_block.hpp"
+
+
+namespace schifra
+{
+
+   namespace reed_solomon
+   {
+
+      namespace details
+      {
+         struct erasure_cache_owner
+         {
+            /*
+              The code whose erasure patterns (or recovery matrices) a
+              cache holds. A workspace may be passed to any decoder of the
+              same <code_length,fec_length> - be it of another generator
+              initial index, or a core sized upon a shortened code - whose
+              patterns differ for the very same erasure set.
+            */
+
+            erasure_cache_owner()
+            : field(0),
+              code_length(0),
+              fec_length(0),
+              gen_initial_index(0)
+            {}
+
+            erasure_cache_owner(const galois::field* f,
+                                const std::size_t    n,
+                                const std::size_t    fec,
+                                const unsigned int   index)
+            : field(f),
+              code_length(n),
+              fec_length(fec),
+              gen_initial_index(index)
+            {}
+
+            inline bool operator==(const erasure_cache_owner& owner) const
+            {
+               return (field             == owner.field            ) &&
+                      (code_length       == owner.code_length      ) &&
+                      (fec_length        == owner.fec_length       ) &&
+                      (gen_initial_index == owner.gen_initial_index) ;
+            }
+
+            const galois::field* field;
+            std::size_t          code_length;
+            std::size_t          fec_length;
+            unsigned int         gen_initial_index;
+         };
+
+         template <typename Entry>
+         inline Entry& lookup_cache_entry(Entry             entry[],
+                                          std::size_t&      entry_count,
+                                          const std::size_t capacity,
+                                          std::size_t&      clock,
+                                          const std::size_t erasure_key[],
+                                          const std::size_t erasure_count,
+                                          bool&             found)
+         {
+            /*
+              The small LRU caches keyed by a sorted erasure set, their
+              entries holding the set as erasure_count and erasures. When
+              not found, the least recently used entry (or a free one) is
+              returned, for the caller to fill with the given set.
+            */
+
+            ++clock;
+
+            std::size_t victim = 0;
+
+            for (std::size_t i = 0; i < entry_count; ++i)
+            {
+               Entry& e = entry[i];
+
+               if (
+                    (e.erasure_count == erasure_count) &&
+                    std::equal(erasure_key, erasure_key + erasure_count, &e.erasures[0])
+                  )
+               {
+                  e.last_used = clock;
+                  found       = true;
+                  return e;
+               }
+
+               if (e.last_used < entry[victim].last_used)
+               {
+                  victim = i;
+               }
+            }
+
+            if (entry_count < capacity)
+            {
+               victim = entry_count++;
+            }
+
+            entry[victim].last_used = clock;
+            found                   = false;
+
+            return entry[victim];
+         }
+
+         class erasure_recovery
+         {
+         public:
+
+            /*
+              Erasure only decoding of a code of code_length symbols whose
+              generator has the roots alpha^b .. alpha^(b + m - 1). With
+              X(p) = alpha^(n-1-p) the locator of position p, any m symbols
+              E are given from the others by the first m syndromes, and
+              with S a set of n - m known positions (the sources):
+
+                 c[e] = sum[s in S] R[e][s] * c[s]
+
+                 R[e][s] = (X(s) / X(e))^b * P(X(s)) / ((X(s) + X(e)) * P'(X(e)))
+
+              where P(x) = prod[j in E](x + X(j)), E being the positions
+              other than the sources. That is R[e][s] = W(s) / ((X(s) + X(e))
+              * W(e)), with W(p) = X(p)^b * prod[j in E, j != p](X(p) + X(j)).
+              The matrix of a set of missing positions is computed once, and
+              kept in a small LRU cache owned by the caller, as the same
+              positions commonly stay missing for many stacks or stripes.
+            */
+
+            enum { cache_size = 8 };
+
+            struct matrix
+            {
+               /*
+                 The coefficients of R, one row of source_count per erased
+                 (target) position, the erasures being sorted.
+               */
+
+               matrix()
+               : erasure_count(0),
+                 last_used(0)
+               {}
+
+               std::size_t                       erasure_count;
+               std::vector<std::size_t>          erasures;
+               std::vector<std::size_t>          sources;
+               std::vector<galois::field_symbol> coefficient;
+               std::size_t                       last_used;
+            };
+
+            struct cache
+            {
+               /*
+                 The matrices are of the one code, hence the cache is
+                 flushed when used with the recovery of another code.
+                 The scratch space of building a matrix is kept along.
+               */
+
+               cache()
+               : entry(cache_size),
+                 entry_count(0),
+                 clock(0)
+               {}
+
+               std::vector<matrix>               entry;
+               std::size_t                       entry_count;
+               std::size_t                       clock;
+               erasure_cache_owner               owner;
+               std::vector<std::size_t>          key;
+               std::vector<std::size_t>          others;
+               std::vector<galois::field_symbol> weight;
+            };
+
+            erasure_recovery(const galois::field& field,
+                             const std::size_t    code_length,
+                             const std::size_t    source_count,
+                             const unsigned int   gen_initial_index)
+            : field_(field),
+              code_length_(code_length),
+              source_count_(source_count),
+              gen_initial_index_(gen_initial_index)
+            {}
+
+            inline galois::field_symbol locator(const std::size_t position) const
+            {
+               return field_.alpha(static_cast<galois::field_symbol>(code_length_ - 1 - position));
+            }
+
+            inline galois::field_symbol initial_power(const std::size_t position) const
+            {
+               // X(position)^b
+               return field_.alpha(static_cast<galois::field_symbol>(
+                         (gen_initial_index_ * (code_length_ - 1 - position)) % field_.size()));
+            }
+
+            inline galois::field_symbol weight(const std::size_t position, const std::vector<std::size_t>& others) const
+            {
+               // W(position) = X(position)^b * prod[j in others, j != position](X(position) + X(j))
+               const galois::field_symbol x = locator(position);
+
+               galois::field_symbol result = initial_power(position);
+
+               for (std::size_t j = 0; j < others.size(); ++j)
+               {
+                  if (others[j] != position)
+                  {
+                     result = field_.mul(result, x ^ locator(others[j]));
+                  }
+               }
+
+               return result;
+            }
+
+            inline galois::field_symbol coefficient(const galois::field_symbol source_weight,
+                                                    const std::size_t          source,
+                                                    const galois::field_symbol target_locator,
+                                                    const galois::field_symbol target_scale) const
+            {
+               // R[e][s] = W(s) / ((X(s) + X(e)) * W(e)), target_scale being 1 / W(e)
+               return field_.mul(field_.div(source_weight, locator(source) ^ target_locator), target_scale);
+            }
+
+            void build(const std::size_t erasure[], const std::size_t erasure_count, matrix& m, cache& c) const
+            {
+               /*
+                 The erasures are sorted and unique. The sources are the
+                 first source_count positions not erased, the other
+                 positions (the erasures and any unused survivors) forming E.
+               */
+
+               m.erasure_count = erasure_count;
+               m.erasures.assign(erasure, erasure + erasure_count);
+               m.sources.clear();
+               c.others.clear();
+
+               for (std::size_t p = 0, e = 0; p < code_length_; ++p)
+               {
+                  if ((e < erasure_count) && (erasure[e] == p))
+                  {
+                     ++e;
+                     c.others.push_back(p);
+                  }
+                  else if (m.sources.size() < source_count_)
+                     m.sources.push_back(p);
+                  else
+                     c.others.push_back(p);
+               }
+
+               c.weight.resize(source_count_);
+
+               for (std::size_t s = 0; s < source_count_; ++s)
+               {
+                  c.weight[s] = weight(m.sources[s], c.others);
+               }
+
+               m.coefficient.resize(erasure_count * source_count_);
+
+               for (std::size_t t = 0; t < erasure_count; ++t)
+               {
+                  const galois::field_symbol x     = locator(erasure[t]);
+                  const galois::field_symbol scale = field_.inverse(weight(erasure[t], c.others));
+
+                  galois::field_symbol* r = &m.coefficient[t * source_count_];
+
+                  for (std::size_t s = 0; s < source_count_; ++s)
+                  {
+                     r[s] = coefficient(c.weight[s], m.sources[s], x, scale);
+                  }
+               }
+            }
+
+            const matrix* lookup(const erasure_locations_t& targets, cache& c) const
+            {
+               /*
+                 The matrix recovering the targets, from the cache or built
+                 into it. Returns null should there be no targets, or should
+                 they not be unique positions within the code, or be more
+                 than it can recover.
+               */
+
+               if (targets.empty() || ((targets.size() + source_count_) > code_length_))
+               {
+                  return 0;
+               }
+
+               c.key.assign(targets.begin(), targets.end());
+
+               std::sort(c.key.begin(), c.key.end());
+
+               for (std::size_t i = 0; i < c.key.size(); ++i)
+               {
+                  if (
+                       (c.key[i] >= code_length_) ||
+                       ((i > 0) && (c.key[i] == c.key[i - 1]))
+                     )
+                  {
+                     return 0;
+                  }
+               }
+
+               const erasure_cache_owner owner(&field_, code_length_, code_length_ - source_count_, gen_initial_index_);
+
+               if (!(c.owner == owner))
+               {
+                  c.entry_count = 0;
+                  c.owner       = owner;
+               }
+
+               bool found = false;
+
+               matrix& m = lookup_cache_entry(&c.entry[0], c.entry_count, c.entry.size(), c.clock, &c.key[0], c.key.size(), found);
+
+               if (!found)
+               {
+                  build(&c.key[0], c.key.size(), m, c);
+               }
+
+               return &m;
+            }
+
+            inline const galois::field& field() const
+            {
+               return field_;
+            }
+
+            inline std::size_t code_length() const
+            {
+               return code_length_;
+            }
+
+            inline std::size_t source_count() const
+            {
+               return source_count_;
+            }
+
+         private:
+
+            const galois::field& field_;
+            const std::size_t    code_length_;
+            const std::size_t    source_count_;
+            const unsigned int   gen_initial_index_;
+         };
+
+      } // namespace details
+
+   } // namespace reed_solomon
+
+} // namespace schifra
+
+#endif
@@ -0,0 +1,145 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+/*
+   Description: This example will demonstrate how to instantiate Reed-Solomon
+                codecs whose code length and fec length are only known at
+                runtime (including shortened codes), add errors and erasures,
+                correct them, and output the various pieces of relevant
+                information.
+*/
+
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "schifra_galois_field.hpp"
+#include "schifra_reed_solomon_runtime_codec.hpp"
+
+
+bool process(const schifra::reed_solomon::runtime_codec& codec, const std::string& message)
+{
+   typedef schifra::reed_solomon::runtime_codec codec_t;
+
+   std::vector<schifra::galois::field_symbol> codeword(codec.code_length(), 0);
+
+   for (std::size_t i = 0; (i < codec.data_length()) && (i < message.size()); ++i)
+   {
+      codeword[i] = static_cast<unsigned char>(message[i]);
+   }
+
+   /* Transform message into Reed-Solomon encoded codeword */
+   if (!codec.encode(&codeword[0]))
+   {
+      std::cout << "Error - Critical encoding failure!" << std::endl;
+      return false;
+   }
+
+   const std::vector<schifra::galois::field_symbol> original = codeword;
+
+   /* Erase the first quarter of the fec length, then add errors every 5th symbol */
+   schifra::reed_solomon::erasure_locations_t erasure_list;
+
+   const std::size_t erasure_count = codec.fec_length() >> 2;
+   const std::size_t error_count   = (codec.fec_length() - erasure_count) >> 1;
+
+   for (std::size_t i = 0; i < erasure_count; ++i)
+   {
+      codeword[i] = 0;
+      erasure_list.push_back(i);
+   }
+
+   for (std::size_t i = 0; i < error_count; ++i)
+   {
+      codeword[erasure_count + (5 * i)] ^= 0x5A;
+   }
+
+   codec_t::workspace workspace(codec.fec_length());
+   codec_t::status    status;
+
+   if (!codec.decode(&codeword[0], erasure_list, status, workspace))
+   {
+      std::cout << "Error - Critical decoding failure! Error: " << status.error << std::endl;
+      return false;
+   }
+   else if (codeword != original)
+   {
+      std::cout << "Error - Error correction failed!" << std::endl;
+      return false;
+   }
+
+   std::cout << "Codec Parameters [" << codec.code_length() << ","
+                                     << codec.data_length() << ","
+                                     << codec.fec_length()  << "]  "
+             << "Errata Detected: "  << status.errors_detected  << "  "
+             << "Errata Corrected: " << status.errors_corrected << std::endl;
+
+   return true;
+}
+
+int main()
+{
+   /* Finite Field Parameters */
+   const std::size_t field_descriptor           =   8;
+   const unsigned int generator_polynomial_index = 120;
+
+   /* Instantiate Finite Field */
+   const schifra::galois::field field(field_descriptor,
+                                      schifra::galois::primitive_polynomial_size06,
+                                      schifra::galois::primitive_polynomial06);
+
+   /* Reed Solomon Code Parameters, eg: as negotiated at runtime */
+   const std::size_t code_parameters[][2] =
+                        {
+                           { 255, 32 },
+                           { 255, 16 },
+                           { 204, 16 },
+                           { 128, 10 },
+                           {  72,  8 }
+                        };
+
+   const std::size_t code_parameters_count = sizeof(code_parameters) / sizeof(code_parameters[0]);
+
+   const std::string message = "An expert is someone who knows more and more about less and "
+                               "less until they know absolutely everything about nothing";
+
+   for (std::size_t i = 0; i < code_parameters_count; ++i)
+   {
+      const schifra::reed_solomon::runtime_codec codec(field,
+                                                       code_parameters[i][0],
+                                                       code_parameters[i][1],
+                                                       generator_polynomial_index);
+
+      if (!codec.valid())
+      {
+         std::cout << "Error - Invalid codec parameters!" << std::endl;
+         return 1;
+      }
+
+      if (!process(codec, message))
+         return 1;
+   }
+
+   return 0;
+}
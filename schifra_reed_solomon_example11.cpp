@@ -0,0 +1,143 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+/*
+   Description: This example will demonstrate how to close the loop between
+                the decoder's statistics and the code rate. A rate controller
+                observes the decoded blocks of a simulated channel whose
+                symbol error rate changes over time, and switches the runtime
+                codec's fec length so as to maximize goodput.
+*/
+
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "schifra_galois_field.hpp"
+#include "schifra_reed_solomon_runtime_codec.hpp"
+#include "schifra_reed_solomon_rate_controller.hpp"
+
+
+int main()
+{
+   /* Finite Field Parameters */
+   const std::size_t field_descriptor           =   8;
+   const unsigned int generator_polynomial_index = 120;
+
+   /* Instantiate Finite Field */
+   const schifra::galois::field field(field_descriptor,
+                                      schifra::galois::primitive_polynomial_size06,
+                                      schifra::galois::primitive_polynomial06);
+
+   /* Reed Solomon Code Parameters */
+   const std::size_t code_length = 255;
+   const std::size_t fec_length_list[] = { 2, 4, 8, 16, 24, 32, 48, 64 };
+   const std::size_t fec_length_count  = sizeof(fec_length_list) / sizeof(std::size_t);
+
+   typedef schifra::reed_solomon::runtime_codec codec_t;
+
+   std::vector<codec_t*> codec_list(fec_length_list[fec_length_count - 1] + 1, reinterpret_cast<codec_t*>(0));
+
+   for (std::size_t i = 0; i < fec_length_count; ++i)
+   {
+      codec_list[fec_length_list[i]] = new codec_t(field, code_length, fec_length_list[i], generator_polynomial_index);
+   }
+
+   schifra::reed_solomon::rate_controller controller(code_length,
+                                                     std::vector<std::size_t>(fec_length_list, fec_length_list + fec_length_count),
+                                                     512);
+
+   /* Channel phases: blocks and symbol error probability (per 10000 symbols) */
+   const std::size_t phase_list[][2] =
+                        {
+                           { 4096,   0 },
+                           { 4096,  20 },
+                           { 4096, 150 },
+                           { 4096,   0 }
+                        };
+
+   const std::size_t phase_count = sizeof(phase_list) / sizeof(phase_list[0]);
+
+   codec_t::workspace workspace(fec_length_list[fec_length_count - 1]);
+   codec_t::status    status;
+
+   const schifra::reed_solomon::erasure_locations_t no_erasures;
+
+   std::vector<schifra::galois::field_symbol> codeword(code_length);
+   std::vector<schifra::galois::field_symbol> original(code_length);
+
+   ::srand(0xA5A5A5A5);
+
+   for (std::size_t phase = 0; phase < phase_count; ++phase)
+   {
+      std::size_t data_symbols_delivered = 0;
+      std::size_t failures               = 0;
+
+      for (std::size_t block = 0; block < phase_list[phase][0]; ++block)
+      {
+         const codec_t& codec = *codec_list[controller.fec_length()];
+
+         for (std::size_t i = 0; i < codec.data_length(); ++i)
+         {
+            codeword[i] = ::rand() & 0xFF;
+         }
+
+         codec.encode(&codeword[0]);
+
+         original = codeword;
+
+         for (std::size_t i = 0; i < code_length; ++i)
+         {
+            if (static_cast<std::size_t>(::rand() % 10000) < phase_list[phase][1])
+            {
+               codeword[i] ^= 1 + (::rand() % 255);
+            }
+         }
+
+         const bool decoded = codec.decode(&codeword[0], no_erasures, status, workspace);
+
+         if (decoded && (codeword == original))
+            data_symbols_delivered += codec.data_length();
+         else
+            ++failures;
+
+         controller.update(status.errors_detected, 0, decoded);
+      }
+
+      std::cout << "Phase: "             << phase                                  << "\t"
+                << "Symbol Error Rate: " << (phase_list[phase][1] / 10000.0)       << "\t"
+                << "Final FEC Length: "  << controller.fec_length()                << "\t"
+                << "Failures: "          << failures                               << "\t"
+                << "Goodput: "           << (static_cast<double>(data_symbols_delivered) / (phase_list[phase][0] * code_length)) << std::endl;
+   }
+
+   std::cout << "Rate Switches: " << controller.switch_count() << std::endl;
+
+   for (std::size_t i = 0; i < fec_length_count; ++i)
+   {
+      delete codec_list[fec_length_list[i]];
+   }
+
+   return 0;
+}
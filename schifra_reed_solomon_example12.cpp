@@ -0,0 +1,308 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+
+/*
+   Description: This example will demonstrate how to encode and decode data
+                in place, within the caller's own buffers. A buffer of
+                packets, each a run of bytes, has its fec symbols kept in a
+                separate trailer buffer. Block views over the two are
+                encoded and decoded without copying the data into blocks.
+                The same is shown for a block whose symbols are stored as
+                bytes, which is a quarter of the size of the default block,
+                for a payload scattered over fragments, and for the columns
+                of an erasure channel stack, which are encoded and decoded
+                through strided views.
+*/
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "schifra_galois_field.hpp"
+#include "schifra_galois_field_polynomial.hpp"
+#include "schifra_sequential_root_generator_polynomial_creator.hpp"
+#include "schifra_reed_solomon_encoder.hpp"
+#include "schifra_reed_solomon_decoder.hpp"
+#include "schifra_reed_solomon_block.hpp"
+#include "schifra_erasure_channel.hpp"
+
+
+int main()
+{
+   /* Finite Field Parameters */
+   const std::size_t field_descriptor                =   8;
+   const std::size_t generator_polynomial_index      = 120;
+   const std::size_t generator_polynomial_root_count =  32;
+
+   /* Reed Solomon Code Parameters */
+   const std::size_t code_length = 255;
+   const std::size_t fec_length  =  32;
+   const std::size_t data_length = code_length - fec_length;
+
+   /* Instantiate Finite Field and Generator Polynomials */
+   const schifra::galois::field field(field_descriptor,
+                                      schifra::galois::primitive_polynomial_size06,
+                                      schifra::galois::primitive_polynomial06);
+
+   schifra::galois::field_polynomial generator_polynomial(field);
+
+   if (
+        !schifra::make_sequential_root_generator_polynomial(field,
+                                                            generator_polynomial_index,
+                                                            generator_polynomial_root_count,
+                                                            generator_polynomial)
+      )
+   {
+      std::cout << "Error - Failed to create sequential root generator!" << std::endl;
+      return 1;
+   }
+
+   /* Instantiate Encoder and Decoder (Codec) */
+   typedef schifra::reed_solomon::encoder<code_length,fec_length,data_length> encoder_t;
+   typedef schifra::reed_solomon::decoder<code_length,fec_length,data_length> decoder_t;
+
+   const encoder_t encoder(field, generator_polynomial);
+   const decoder_t decoder(field, generator_polynomial_index);
+
+   typedef schifra::reed_solomon::block_view<code_length,fec_length,unsigned char> view_t;
+   typedef schifra::reed_solomon::block<code_length,fec_length,data_length,unsigned char> byte_block_t;
+   typedef schifra::reed_solomon::block<code_length,fec_length> block_t;
+
+   const std::size_t packet_count = 64;
+
+   std::vector<unsigned char> payload(packet_count * data_length);
+   std::vector<unsigned char> trailer(packet_count * fec_length );
+
+   ::srand(0x5A5A5A5A);
+
+   for (std::size_t i = 0; i < payload.size(); ++i)
+   {
+      payload[i] = static_cast<unsigned char>(::rand() & 0xFF);
+   }
+
+   const std::vector<unsigned char> original_payload = payload;
+
+   /* Encode each packet, the fec symbols being written into the trailer */
+   for (std::size_t i = 0; i < packet_count; ++i)
+   {
+      view_t view(&payload[i * data_length], &trailer[i * fec_length]);
+
+      if (!encoder.encode(view))
+      {
+         std::cout << "Error - Critical encoding failure! "
+                   << "Msg: " << view.error_as_string() << std::endl;
+         return 1;
+      }
+   }
+
+   /* The fec symbols must be those of the default block */
+   for (std::size_t i = 0; i < packet_count; ++i)
+   {
+      block_t block;
+
+      for (std::size_t j = 0; j < data_length; ++j)
+      {
+         block[j] = payload[i * data_length + j];
+      }
+
+      encoder.encode(block);
+
+      for (std::size_t j = 0; j < fec_length; ++j)
+      {
+         if (block.fec(j) != trailer[i * fec_length + j])
+         {
+            std::cout << "Error - Block view fec mismatch at packet: " << i << std::endl;
+            return 1;
+         }
+      }
+   }
+
+   /* Corrupt each packet, both its payload and its trailer, up to the limit */
+   for (std::size_t i = 0; i < packet_count; ++i)
+   {
+      for (std::size_t j = 0; j < (fec_length >> 1); ++j)
+      {
+         const std::size_t position = (i + 7 * j) % code_length;
+
+         unsigned char& symbol = (position < data_length) ?
+                                 payload[i * data_length + position] :
+                                 trailer[i * fec_length  + (position - data_length)];
+
+         symbol ^= static_cast<unsigned char>(1 + ((i + j) % 255));
+      }
+   }
+
+   /* Decode each packet in place */
+   decoder_t::workspace workspace;
+
+   std::size_t errors_corrected = 0;
+
+   for (std::size_t i = 0; i < packet_count; ++i)
+   {
+      view_t view(&payload[i * data_length], &trailer[i * fec_length]);
+
+      if (!decoder.decode(view, workspace))
+      {
+         std::cout << "Error - Critical decoding failure! "
+                   << "Msg: " << view.error_as_string() << std::endl;
+         return 1;
+      }
+
+      errors_corrected += view.errors_corrected;
+   }
+
+   if (payload != original_payload)
+   {
+      std::cout << "Error - Decoded payload does not match the original!" << std::endl;
+      return 1;
+   }
+
+   std::cout << "Packets: " << packet_count << "\tErrors Corrected: " << errors_corrected << std::endl;
+
+   /* A block whose symbols are stored as bytes, with erasures */
+   byte_block_t byte_block;
+
+   for (std::size_t i = 0; i < data_length; ++i)
+   {
+      byte_block[i] = original_payload[i];
+   }
+
+   encoder.encode(byte_block);
+
+   const byte_block_t original_byte_block = byte_block;
+
+   schifra::reed_solomon::erasure_locations_t erasure_list;
+
+   for (std::size_t i = 0; i < fec_length; ++i)
+   {
+      erasure_list.push_back(3 * i);
+      byte_block[3 * i] = 0;
+   }
+
+   if (!decoder.decode(byte_block, erasure_list))
+   {
+      std::cout << "Error - Critical decoding failure! "
+                << "Msg: " << byte_block.error_as_string() << std::endl;
+      return 1;
+   }
+
+   for (std::size_t i = 0; i < code_length; ++i)
+   {
+      if (byte_block[i] != original_byte_block[i])
+      {
+         std::cout << "Error - Decoded byte block does not match the original!" << std::endl;
+         return 1;
+      }
+   }
+
+   std::cout << "Byte Block Size: "     << sizeof(byte_block_t)       << "\t"
+             << "Block Size: "          << sizeof(block_t)            << "\t"
+             << "Erasures Corrected: "  << byte_block.errors_corrected << std::endl;
+
+   /* A payload scattered over fragments of differing lengths */
+   typedef schifra::reed_solomon::segment<unsigned char> segment_t;
+   typedef schifra::reed_solomon::segmented_block_view<code_length,fec_length,unsigned char> segmented_view_t;
+
+   std::vector<unsigned char> fragments(payload.begin(), payload.begin() + data_length);
+   std::vector<unsigned char> segmented_fec(fec_length);
+
+   const segment_t segment_list[] =
+                      {
+                        segment_t(&fragments[  0],               1),
+                        segment_t(&fragments[  1],              99),
+                        segment_t(&fragments[100],               0),
+                        segment_t(&fragments[100], data_length - 100)
+                      };
+
+   segmented_view_t segmented_view(segment_list, sizeof(segment_list) / sizeof(segment_t), &segmented_fec[0]);
+
+   encoder.encode(segmented_view);
+
+   if (!std::equal(segmented_fec.begin(), segmented_fec.end(), trailer.begin()))
+   {
+      std::cout << "Error - Segmented view fec mismatch!" << std::endl;
+      return 1;
+   }
+
+   fragments[  0] ^= 0x01;
+   fragments[ 99] ^= 0x02;
+   fragments[100] ^= 0x04;
+   segmented_fec[fec_length - 1] ^= 0x08;
+
+   if (!decoder.decode(segmented_view, workspace) || !std::equal(fragments.begin(), fragments.end(), payload.begin()))
+   {
+      std::cout << "Error - Failed to decode segmented view!" << std::endl;
+      return 1;
+   }
+
+   std::cout << "Segments: " << segmented_view.segment_count() << "\tErrors Corrected: " << segmented_view.errors_corrected << std::endl;
+
+   /* An erasure channel stack whose codewords are its columns */
+   static schifra::reed_solomon::block<code_length,fec_length> block_stack[code_length];
+
+   for (std::size_t row = 0; row < data_length; ++row)
+   {
+      for (std::size_t i = 0; i < code_length; ++i)
+      {
+         block_stack[row][i] = original_payload[(row * code_length + i) % original_payload.size()];
+      }
+   }
+
+   if (!schifra::reed_solomon::erasure_channel_stack_column_encode<code_length,fec_length>(encoder,block_stack))
+   {
+      return 1;
+   }
+
+   /* Lose fec_length rows, as would be the case for lost packets */
+   schifra::reed_solomon::erasure_locations_t missing_row_index;
+
+   for (std::size_t i = 0; i < fec_length; ++i)
+   {
+      missing_row_index.push_back((7 * i) % code_length);
+      block_stack[missing_row_index.back()].clear();
+   }
+
+   if (!schifra::reed_solomon::erasure_channel_stack_column_decode<code_length,fec_length>(decoder,missing_row_index,block_stack))
+   {
+      return 1;
+   }
+
+   for (std::size_t row = 0; row < data_length; ++row)
+   {
+      for (std::size_t i = 0; i < code_length; ++i)
+      {
+         if (block_stack[row][i] != original_payload[(row * code_length + i) % original_payload.size()])
+         {
+            std::cout << "Error - Decoded stack does not match the original!" << std::endl;
+            return 1;
+         }
+      }
+   }
+
+   std::cout << "Stack Rows Recovered: " << missing_row_index.size() << std::endl;
+
+   return 0;
+}
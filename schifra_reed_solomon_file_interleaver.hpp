@@ -94,12 +94,9 @@ namespace schifra
                in_stream.read(&block_stack_[i][0],static_cast<std::streamsize>(block_length));
             }
 
-            interleave<char,block_length,stack_size>(block_stack_);
+            interleave_to<char,block_length>(block_stack_,stack_size,buffer_);
 
-            for (std::size_t i = 0; i < stack_size; ++i)
-            {
-               out_stream.write(&block_stack_[i][0],static_cast<std::streamsize>(block_length));
-            }
+            out_stream.write(buffer_,static_cast<std::streamsize>(block_length * stack_size));
          }
 
          inline void process_incomplete_block(std::ifstream& in_stream,
@@ -136,6 +133,7 @@ namespace schifra
          }
 
          data_block<char,block_length> block_stack_[stack_size];
+         char buffer_[block_length * stack_size];
 
       };
 
@@ -190,12 +188,9 @@ namespace schifra
          inline void process_block(std::ifstream& in_stream,
                                    std::ofstream& out_stream)
          {
-            for (std::size_t i = 0; i < stack_size; ++i)
-            {
-               in_stream.read(&block_stack_[i][0],static_cast<std::streamsize>(block_length));
-            }
+            in_stream.read(buffer_,static_cast<std::streamsize>(block_length * stack_size));
 
-            deinterleave<char,block_length,stack_size>(block_stack_);
+            deinterleave_from<char,block_length>(buffer_,stack_size,block_stack_);
 
             for (std::size_t i = 0; i < stack_size; ++i)
             {
@@ -237,6 +232,7 @@ namespace schifra
          }
 
          data_block<char,block_length> block_stack_[stack_size];
+         char buffer_[block_length * stack_size];
 
       };
 
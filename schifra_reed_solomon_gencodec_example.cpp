@@ -42,7 +42,8 @@
 
 template <std::size_t code_length, std::size_t fec_length>
 bool do_encode_decode(const schifra::reed_solomon::general_codec<code_length>& codec,
-                            schifra::reed_solomon::block<code_length,fec_length>& block)
+                            schifra::reed_solomon::block<code_length,fec_length>& block,
+                            typename schifra::reed_solomon::general_codec<code_length>::workspace& workspace)
 {
    for (int i = 0; i < static_cast<int>(code_length - fec_length); ++i) block[i] = i;
 
@@ -54,7 +55,7 @@ bool do_encode_decode(const schifra::reed_solomon::general_codec<code_length>& c
 
    schifra::corrupt_message_all_errors(block,fec_length >> 1,0,3);
 
-   if (!codec.decode(block))
+   if (!codec.decode(block,workspace))
    {
       std::cout << "do_encode_decode() - Error: Failed to decode block!" << std::endl;
       return false;
@@ -88,6 +89,9 @@ int main()
    /* Reed Solomon Code Parameters */
    schifra::reed_solomon::general_codec<code_length> codec(field, gen_poly_index);
 
+   /* Decoding scratch space, reused across all of the decodes */
+   schifra::reed_solomon::general_codec<code_length>::workspace workspace;
+
    schifra::reed_solomon::block<code_length,  2>  block_fec02;
    schifra::reed_solomon::block<code_length,  4>  block_fec04;
    schifra::reed_solomon::block<code_length,  6>  block_fec06;
@@ -109,26 +113,26 @@ int main()
    schifra::reed_solomon::block<code_length, 96>  block_fec96;
    schifra::reed_solomon::block<code_length,128> block_fec128;
 
-   do_encode_decode(codec, block_fec02);
-   do_encode_decode(codec, block_fec04);
-   do_encode_decode(codec, block_fec06);
-   do_encode_decode(codec, block_fec08);
-   do_encode_decode(codec, block_fec10);
-   do_encode_decode(codec, block_fec12);
-   do_encode_decode(codec, block_fec14);
-   do_encode_decode(codec, block_fec16);
-   do_encode_decode(codec, block_fec18);
-   do_encode_decode(codec, block_fec20);
-   do_encode_decode(codec, block_fec22);
-   do_encode_decode(codec, block_fec24);
-   do_encode_decode(codec, block_fec26);
-   do_encode_decode(codec, block_fec28);
-   do_encode_decode(codec, block_fec30);
-   do_encode_decode(codec, block_fec32);
-   do_encode_decode(codec, block_fec64);
-   do_encode_decode(codec, block_fec80);
-   do_encode_decode(codec, block_fec96);
-   do_encode_decode(codec,block_fec128);
+   do_encode_decode(codec, block_fec02, workspace);
+   do_encode_decode(codec, block_fec04, workspace);
+   do_encode_decode(codec, block_fec06, workspace);
+   do_encode_decode(codec, block_fec08, workspace);
+   do_encode_decode(codec, block_fec10, workspace);
+   do_encode_decode(codec, block_fec12, workspace);
+   do_encode_decode(codec, block_fec14, workspace);
+   do_encode_decode(codec, block_fec16, workspace);
+   do_encode_decode(codec, block_fec18, workspace);
+   do_encode_decode(codec, block_fec20, workspace);
+   do_encode_decode(codec, block_fec22, workspace);
+   do_encode_decode(codec, block_fec24, workspace);
+   do_encode_decode(codec, block_fec26, workspace);
+   do_encode_decode(codec, block_fec28, workspace);
+   do_encode_decode(codec, block_fec30, workspace);
+   do_encode_decode(codec, block_fec32, workspace);
+   do_encode_decode(codec, block_fec64, workspace);
+   do_encode_decode(codec, block_fec80, workspace);
+   do_encode_decode(codec, block_fec96, workspace);
+   do_encode_decode(codec,block_fec128, workspace);
 
    return 0;
 }
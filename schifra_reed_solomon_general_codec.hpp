@@ -30,6 +30,7 @@
 #include "schifra_reed_solomon_block.hpp"
 #include "schifra_reed_solomon_encoder.hpp"
 #include "schifra_reed_solomon_decoder.hpp"
+#include "schifra_reed_solomon_runtime_codec.hpp"
 #include "schifra_ecc_traits.hpp"
 
 
@@ -74,133 +75,133 @@ namespace schifra
       {
       public:
 
+         /*
+           One runtime codec per supported fec length, each with its own
+           encoder and decoder cores (and tables), rather than each fec
+           length instantiating its own encoder and decoder templates -
+           the code of the cores being the one for all fec lengths.
+         */
+
+         class workspace
+         {
+         public:
+
+            /*
+              Owned by the caller and reused across decodes (one per
+              thread), holding a runtime codec workspace per fec length,
+              each allocated upon the first decode of that fec length.
+            */
+
+            workspace()
+            {
+               for (std::size_t i = 0; i <= max_fec_length; ++i)
+               {
+                  workspace_[i] = 0;
+               }
+            }
+
+           ~workspace()
+            {
+               for (std::size_t i = 0; i <= max_fec_length; ++i)
+               {
+                  delete workspace_[i];
+               }
+            }
+
+            inline runtime_codec::workspace& get(const std::size_t fec_length)
+            {
+               if (0 == workspace_[fec_length])
+               {
+                  workspace_[fec_length] = new runtime_codec::workspace(fec_length);
+               }
+
+               return *workspace_[fec_length];
+            }
+
+         private:
+
+            workspace(const workspace&);
+            workspace& operator=(const workspace&);
+
+            runtime_codec::workspace* workspace_[max_fec_length + 1];
+         };
+
          general_codec(const galois::field& field,
                        const std::size_t& gen_poly_index)
          {
-            for (std::size_t i = 0; i < max_fec_length; ++i)
+            static const std::size_t fec_length_list[] =
+                                        {
+                                           2,  4,  6,  8, 10, 12, 14, 16, 18, 20,
+                                          22, 24, 26, 28, 30, 32, 64, 80, 96, 128
+                                        };
+
+            static const std::size_t fec_length_list_size = sizeof(fec_length_list) / sizeof(std::size_t);
+
+            for (std::size_t i = 0; i <= max_fec_length; ++i)
             {
-               encoder_[i] = 0;
-               decoder_[i] = 0;
+               codec_[i] = 0;
             }
 
-            encoder_[  2] = create_encoder<code_length,  2>(field, gen_poly_index);
-            encoder_[  4] = create_encoder<code_length,  4>(field, gen_poly_index);
-            encoder_[  6] = create_encoder<code_length,  6>(field, gen_poly_index);
-            encoder_[  8] = create_encoder<code_length,  8>(field, gen_poly_index);
-            encoder_[ 10] = create_encoder<code_length, 10>(field, gen_poly_index);
-            encoder_[ 12] = create_encoder<code_length, 12>(field, gen_poly_index);
-            encoder_[ 14] = create_encoder<code_length, 14>(field, gen_poly_index);
-            encoder_[ 16] = create_encoder<code_length, 16>(field, gen_poly_index);
-            encoder_[ 18] = create_encoder<code_length, 18>(field, gen_poly_index);
-            encoder_[ 20] = create_encoder<code_length, 20>(field, gen_poly_index);
-            encoder_[ 22] = create_encoder<code_length, 22>(field, gen_poly_index);
-            encoder_[ 24] = create_encoder<code_length, 24>(field, gen_poly_index);
-            encoder_[ 26] = create_encoder<code_length, 26>(field, gen_poly_index);
-            encoder_[ 28] = create_encoder<code_length, 28>(field, gen_poly_index);
-            encoder_[ 30] = create_encoder<code_length, 30>(field, gen_poly_index);
-            encoder_[ 32] = create_encoder<code_length, 32>(field, gen_poly_index);
-            encoder_[ 64] = create_encoder<code_length, 64>(field, gen_poly_index);
-            encoder_[ 80] = create_encoder<code_length, 80>(field, gen_poly_index);
-            encoder_[ 96] = create_encoder<code_length, 96>(field, gen_poly_index);
-            encoder_[128] = create_encoder<code_length,128>(field, gen_poly_index);
-
-            decoder_[  2] = create_decoder<code_length,  2>(field, gen_poly_index);
-            decoder_[  4] = create_decoder<code_length,  4>(field, gen_poly_index);
-            decoder_[  6] = create_decoder<code_length,  6>(field, gen_poly_index);
-            decoder_[  8] = create_decoder<code_length,  8>(field, gen_poly_index);
-            decoder_[ 10] = create_decoder<code_length, 10>(field, gen_poly_index);
-            decoder_[ 12] = create_decoder<code_length, 12>(field, gen_poly_index);
-            decoder_[ 14] = create_decoder<code_length, 14>(field, gen_poly_index);
-            decoder_[ 16] = create_decoder<code_length, 16>(field, gen_poly_index);
-            decoder_[ 18] = create_decoder<code_length, 18>(field, gen_poly_index);
-            decoder_[ 20] = create_decoder<code_length, 20>(field, gen_poly_index);
-            decoder_[ 22] = create_decoder<code_length, 22>(field, gen_poly_index);
-            decoder_[ 24] = create_decoder<code_length, 24>(field, gen_poly_index);
-            decoder_[ 26] = create_decoder<code_length, 26>(field, gen_poly_index);
-            decoder_[ 28] = create_decoder<code_length, 28>(field, gen_poly_index);
-            decoder_[ 30] = create_decoder<code_length, 30>(field, gen_poly_index);
-            decoder_[ 32] = create_decoder<code_length, 32>(field, gen_poly_index);
-            decoder_[ 64] = create_decoder<code_length, 64>(field, gen_poly_index);
-            decoder_[ 80] = create_decoder<code_length, 80>(field, gen_poly_index);
-            decoder_[ 96] = create_decoder<code_length, 96>(field, gen_poly_index);
-            decoder_[128] = create_decoder<code_length,128>(field, gen_poly_index);
+            for (std::size_t i = 0; i < fec_length_list_size; ++i)
+            {
+               const std::size_t fec_length = fec_length_list[i];
+
+               if ((fec_length > max_fec_length) || (fec_length >= code_length))
+                  continue;
+
+               runtime_codec* codec = new runtime_codec(field,
+                                                        code_length,
+                                                        fec_length,
+                                                        static_cast<unsigned int>(gen_poly_index));
+
+               if (codec->valid())
+                  codec_[fec_length] = codec;
+               else
+                  delete codec;
+            }
          }
 
         ~general_codec()
          {
-            delete static_cast<reed_solomon::encoder<code_length,  2>*>(encoder_[  2]);
-            delete static_cast<reed_solomon::encoder<code_length,  4>*>(encoder_[  4]);
-            delete static_cast<reed_solomon::encoder<code_length,  6>*>(encoder_[  6]);
-            delete static_cast<reed_solomon::encoder<code_length,  8>*>(encoder_[  8]);
-            delete static_cast<reed_solomon::encoder<code_length, 10>*>(encoder_[ 10]);
-            delete static_cast<reed_solomon::encoder<code_length, 12>*>(encoder_[ 12]);
-            delete static_cast<reed_solomon::encoder<code_length, 14>*>(encoder_[ 14]);
-            delete static_cast<reed_solomon::encoder<code_length, 16>*>(encoder_[ 16]);
-            delete static_cast<reed_solomon::encoder<code_length, 18>*>(encoder_[ 18]);
-            delete static_cast<reed_solomon::encoder<code_length, 20>*>(encoder_[ 20]);
-            delete static_cast<reed_solomon::encoder<code_length, 22>*>(encoder_[ 22]);
-            delete static_cast<reed_solomon::encoder<code_length, 24>*>(encoder_[ 24]);
-            delete static_cast<reed_solomon::encoder<code_length, 26>*>(encoder_[ 26]);
-            delete static_cast<reed_solomon::encoder<code_length, 28>*>(encoder_[ 28]);
-            delete static_cast<reed_solomon::encoder<code_length, 30>*>(encoder_[ 30]);
-            delete static_cast<reed_solomon::encoder<code_length, 32>*>(encoder_[ 32]);
-            delete static_cast<reed_solomon::encoder<code_length, 64>*>(encoder_[ 64]);
-            delete static_cast<reed_solomon::encoder<code_length, 80>*>(encoder_[ 80]);
-            delete static_cast<reed_solomon::encoder<code_length, 96>*>(encoder_[ 96]);
-            delete static_cast<reed_solomon::encoder<code_length,128>*>(encoder_[128]);
-
-            delete static_cast<reed_solomon::decoder<code_length,  2>*>(decoder_[  2]);
-            delete static_cast<reed_solomon::decoder<code_length,  4>*>(decoder_[  4]);
-            delete static_cast<reed_solomon::decoder<code_length,  6>*>(decoder_[  6]);
-            delete static_cast<reed_solomon::decoder<code_length,  8>*>(decoder_[  8]);
-            delete static_cast<reed_solomon::decoder<code_length, 10>*>(decoder_[ 10]);
-            delete static_cast<reed_solomon::decoder<code_length, 12>*>(decoder_[ 12]);
-            delete static_cast<reed_solomon::decoder<code_length, 14>*>(decoder_[ 14]);
-            delete static_cast<reed_solomon::decoder<code_length, 16>*>(decoder_[ 16]);
-            delete static_cast<reed_solomon::decoder<code_length, 18>*>(decoder_[ 18]);
-            delete static_cast<reed_solomon::decoder<code_length, 20>*>(decoder_[ 20]);
-            delete static_cast<reed_solomon::decoder<code_length, 22>*>(decoder_[ 22]);
-            delete static_cast<reed_solomon::decoder<code_length, 24>*>(decoder_[ 24]);
-            delete static_cast<reed_solomon::decoder<code_length, 26>*>(decoder_[ 26]);
-            delete static_cast<reed_solomon::decoder<code_length, 28>*>(decoder_[ 28]);
-            delete static_cast<reed_solomon::decoder<code_length, 30>*>(decoder_[ 30]);
-            delete static_cast<reed_solomon::decoder<code_length, 32>*>(decoder_[ 32]);
-            delete static_cast<reed_solomon::decoder<code_length, 64>*>(decoder_[ 64]);
-            delete static_cast<reed_solomon::decoder<code_length, 80>*>(decoder_[ 80]);
-            delete static_cast<reed_solomon::decoder<code_length, 96>*>(decoder_[ 96]);
-            delete static_cast<reed_solomon::decoder<code_length,128>*>(decoder_[128]);
+            for (std::size_t i = 0; i <= max_fec_length; ++i)
+            {
+               delete codec_[i];
+            }
          }
 
          template <typename Block>
          bool encode(Block& block) const
          {
-            /*
-               cl : code length
-               fl : fec length
-            */
-            typedef reed_solomon::encoder<Block::trait::code_length,Block::trait::fec_length> encoder_type;
             traits::__static_assert__<(Block::trait::fec_length <= max_fec_length)>();
-            if (encoder_[Block::trait::fec_length] == 0)
+            if (codec_[Block::trait::fec_length] == 0)
                return false;
             else
-               return static_cast<encoder_type*>(encoder_[Block::trait::fec_length])->encode(block);
+               return codec_[Block::trait::fec_length]->encode(block);
          }
 
          template <typename Block>
          bool decode(Block& block) const
          {
-            typedef reed_solomon::decoder<Block::trait::code_length,Block::trait::fec_length> decoder_type;
+            workspace ws;
+            return decode(block, ws);
+         }
+
+         template <typename Block>
+         bool decode(Block& block, workspace& ws) const
+         {
             traits::__static_assert__<(Block::trait::fec_length <= max_fec_length)>();
-            if (decoder_[Block::trait::fec_length] == 0)
+            if (codec_[Block::trait::fec_length] == 0)
                return false;
             else
-               return static_cast<decoder_type*>(decoder_[Block::trait::fec_length])->decode(block);
+               return codec_[Block::trait::fec_length]->decode(block, empty_erasure_list(), ws.get(Block::trait::fec_length));
          }
 
       private:
 
-         void* encoder_[max_fec_length + 1];
-         void* decoder_[max_fec_length + 1];
+         general_codec(const general_codec&);
+         general_codec& operator=(const general_codec&);
+
+         runtime_codec* codec_[max_fec_length + 1];
       };
 
    } // namespace reed_solomon
@@ -24,12 +24,19 @@
 #define INCLUDE_SCHIFRA_REED_SOLOMON_INTERLEAVING_HPP
 
 
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
 #include <string>
+#include <vector>
 
+#include "schifra_cpu_features.hpp"
 #include "schifra_reed_solomon_block.hpp"
 
+#if defined(SCHIFRA_X86_DISPATCH)
+   #include <immintrin.h>
+#endif
+
 
 namespace schifra
 {
@@ -37,598 +44,1309 @@ namespace schifra
    namespace reed_solomon
    {
 
-      template <std::size_t code_length, std::size_t fec_length>
-      inline void interleave(block<code_length,fec_length> (&block_stack)[code_length])
+      namespace details
       {
-         for (std::size_t i = 0; i < code_length; ++i)
+
+         /*
+           Stacks are transposed in tiles: each pair of tiles mirrored about
+           the diagonal is exchanged whole, while both are held in cache -
+           or, for the one and four byte integral symbols, in vector
+           registers (16x16 with SSSE3, 8x8 with AVX2) - rather than by
+           single symbol swaps that stride a whole row per access. The rows
+           of a stack are given as row pointers, as the rows of a stack of
+           blocks are not evenly spaced symbols.
+         */
+
+         template <typename T> struct transpose_traits                { enum { vector_symbol_size = 0 }; };
+         template <>           struct transpose_traits<char>          { enum { vector_symbol_size = 1 }; };
+         template <>           struct transpose_traits<signed char>   { enum { vector_symbol_size = 1 }; };
+         template <>           struct transpose_traits<unsigned char> { enum { vector_symbol_size = 1 }; };
+         template <>           struct transpose_traits<int>           { enum { vector_symbol_size = 4 }; };
+         template <>           struct transpose_traits<unsigned int>  { enum { vector_symbol_size = 4 }; };
+
+         enum { scalar_tile_size = 8 };
+
+         template <typename T>
+         inline std::size_t transpose_tile_size()
          {
-            for (std::size_t j = i + 1; j < code_length; ++j)
-            {
-               typename block<code_length,fec_length>::symbol_type tmp = block_stack[i][j];
-               block_stack[i][j] = block_stack[j][i];
-               block_stack[j][i] = tmp;
-           }
-         }
-      }
+            #if defined(SCHIFRA_X86_DISPATCH)
+            const cpu::level level = cpu::active_level();
 
-      template <std::size_t code_length, std::size_t fec_length, std::size_t row_count>
-      inline void interleave(block<code_length,fec_length> (&block_stack)[row_count])
-      {
-         block<code_length,fec_length> auxiliary_stack[row_count];
+            if ((1 == transpose_traits<T>::vector_symbol_size) && (level >= cpu::ssse3))
+               return 16;
+            else if ((4 == transpose_traits<T>::vector_symbol_size) && (level >= cpu::avx2))
+               return 8;
+            #endif
 
-         std::size_t aux_row   = 0;
-         std::size_t aux_index = 0;
+            return scalar_tile_size;
+         }
+
+         #if defined(SCHIFRA_X86_DISPATCH)
 
-         for (std::size_t index = 0; index < code_length; ++index)
+         __attribute__((target("ssse3")))
+         inline void transpose_16x16(__m128i r[16])
          {
-            for (std::size_t row = 0; row < row_count; ++row)
-            {
-               auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
+            __m128i a[16];
+            __m128i b[16];
 
-               if (++aux_index == code_length)
-               {
-                  aux_index = 0;
-                  aux_row++;
-               }
+            for (std::size_t i = 0; i < 8; ++i)
+            {
+               a[i    ] = _mm_unpacklo_epi8(r[2 * i], r[2 * i + 1]);
+               a[i + 8] = _mm_unpackhi_epi8(r[2 * i], r[2 * i + 1]);
             }
-         }
 
-         copy<code_length,fec_length,row_count>(auxiliary_stack,block_stack);
-      }
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+               b[i     ] = _mm_unpacklo_epi16(a[    2 * i], a[    2 * i + 1]);
+               b[i +  4] = _mm_unpackhi_epi16(a[    2 * i], a[    2 * i + 1]);
+               b[i +  8] = _mm_unpacklo_epi16(a[8 + 2 * i], a[8 + 2 * i + 1]);
+               b[i + 12] = _mm_unpackhi_epi16(a[8 + 2 * i], a[8 + 2 * i + 1]);
+            }
 
-      template <std::size_t code_length, std::size_t fec_length, std::size_t row_count>
-      inline void interleave(block<code_length,fec_length,row_count> (&block_stack)[row_count],
-                             const std::size_t partial_code_length)
-      {
-         if (partial_code_length == code_length)
-         {
-            interleave<code_length,fec_length,row_count>(block_stack);
+            for (std::size_t g = 0; g < 16; g += 4)
+            {
+               a[g    ] = _mm_unpacklo_epi32(b[g    ], b[g + 1]);
+               a[g + 1] = _mm_unpacklo_epi32(b[g + 2], b[g + 3]);
+               a[g + 2] = _mm_unpackhi_epi32(b[g    ], b[g + 1]);
+               a[g + 3] = _mm_unpackhi_epi32(b[g + 2], b[g + 3]);
+
+               r[g    ] = _mm_unpacklo_epi64(a[g    ], a[g + 1]);
+               r[g + 1] = _mm_unpackhi_epi64(a[g    ], a[g + 1]);
+               r[g + 2] = _mm_unpacklo_epi64(a[g + 2], a[g + 3]);
+               r[g + 3] = _mm_unpackhi_epi64(a[g + 2], a[g + 3]);
+            }
          }
-         else
+
+         __attribute__((target("avx2")))
+         inline void transpose_8x8(__m256i r[8])
          {
-            block<code_length,fec_length,row_count> auxiliary_stack[row_count];
+            __m256i a[8];
 
-            std::size_t aux_row   = 0;
-            std::size_t aux_index = 0;
+            for (std::size_t i = 0; i < 8; i += 2)
+            {
+               a[i    ] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+               a[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+            }
 
-            for (std::size_t index = 0; index < partial_code_length; ++index)
+            for (std::size_t i = 0; i < 8; i += 4)
             {
-               for (std::size_t row = 0; row < row_count; ++row)
-               {
-                  auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
+               r[i    ] = _mm256_unpacklo_epi64(a[i    ], a[i + 2]);
+               r[i + 1] = _mm256_unpackhi_epi64(a[i    ], a[i + 2]);
+               r[i + 2] = _mm256_unpacklo_epi64(a[i + 1], a[i + 3]);
+               r[i + 3] = _mm256_unpackhi_epi64(a[i + 1], a[i + 3]);
+            }
 
-                  if (++aux_index == code_length)
-                  {
-                     aux_index = 0;
-                     aux_row++;
-                  }
-               }
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+               a[i    ] = _mm256_permute2x128_si256(r[i], r[i + 4], 0x20);
+               a[i + 4] = _mm256_permute2x128_si256(r[i], r[i + 4], 0x31);
             }
 
-            for (std::size_t index = partial_code_length; index < code_length; ++index)
+            for (std::size_t i = 0; i < 8; ++i)
             {
-               for (std::size_t row = 0; row < row_count - 1; ++row)
-               {
-                  auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
+               r[i] = a[i];
+            }
+         }
 
-                  if (++aux_index == code_length)
-                  {
-                     aux_index = 0;
-                     aux_row++;
-                  }
-               }
+         template <bool exchange, typename T>
+         __attribute__((target("ssse3")))
+         inline void transpose_tiles_ssse3(T* const a[], const std::size_t a_col, T* const b[], const std::size_t b_col)
+         {
+            __m128i ta[16];
+            __m128i tb[16];
+
+            const bool diagonal = (a == b) && (a_col == b_col);
+
+            for (std::size_t k = 0; k < 16; ++k)
+            {
+               ta[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a[k] + a_col));
             }
 
-            for (std::size_t row = 0; row < row_count - 1; ++row)
+            if (exchange && !diagonal)
             {
-               for (std::size_t index = 0; index < code_length - fec_length; ++index)
+               for (std::size_t k = 0; k < 16; ++k)
                {
-                  block_stack[row].data[index] = auxiliary_stack[row].data[index];
+                  tb[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b[k] + b_col));
                }
-               for (std::size_t index = 0; index < fec_length; ++index)
+
+               transpose_16x16(tb);
+
+               for (std::size_t k = 0; k < 16; ++k)
                {
-                  block_stack[row].fec[index] = auxiliary_stack[row].fec[index];
+                  _mm_storeu_si128(reinterpret_cast<__m128i*>(a[k] + a_col), tb[k]);
                }
             }
 
-            for (std::size_t index = 0; index < partial_code_length; ++index)
+            transpose_16x16(ta);
+
+            for (std::size_t k = 0; k < 16; ++k)
             {
-               block_stack[row_count - 1][index] = auxiliary_stack[row_count - 1][index];
+               _mm_storeu_si128(reinterpret_cast<__m128i*>(b[k] + b_col), ta[k]);
             }
          }
-      }
 
-      template <typename T, std::size_t block_length>
-      inline void interleave(data_block<T,block_length> (&block_stack)[block_length])
-      {
-         for (std::size_t i = 0; i < block_length; ++i)
+         template <bool exchange, typename T>
+         __attribute__((target("avx2")))
+         inline void transpose_tiles_avx2(T* const a[], const std::size_t a_col, T* const b[], const std::size_t b_col)
          {
-            for (std::size_t j = i + 1; j < block_length; ++j)
-            {
-               T tmp = block_stack[i][j];
-               block_stack[i][j] = block_stack[j][i];
-               block_stack[j][i] = tmp;
-           }
-         }
-      }
+            __m256i ta[8];
+            __m256i tb[8];
 
-      template <typename T, std::size_t block_length, std::size_t row_count>
-      inline void interleave(data_block<T,block_length> (&block_stack)[row_count])
-      {
-         data_block<T,block_length> auxiliary_stack[row_count];
+            const bool diagonal = (a == b) && (a_col == b_col);
 
-         std::size_t aux_row   = 0;
-         std::size_t aux_index = 0;
+            for (std::size_t k = 0; k < 8; ++k)
+            {
+               ta[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a[k] + a_col));
+            }
 
-         for (std::size_t index = 0; index < block_length; ++index)
-         {
-            for (std::size_t row = 0; row < row_count; ++row)
+            if (exchange && !diagonal)
             {
-               auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
+               for (std::size_t k = 0; k < 8; ++k)
+               {
+                  tb[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b[k] + b_col));
+               }
 
-               if (++aux_index == block_length)
+               transpose_8x8(tb);
+
+               for (std::size_t k = 0; k < 8; ++k)
                {
-                  aux_index = 0;
-                  aux_row++;
+                  _mm256_storeu_si256(reinterpret_cast<__m256i*>(a[k] + a_col), tb[k]);
                }
             }
-         }
 
-         copy<T,block_length,row_count>(auxiliary_stack,block_stack);
-      }
+            transpose_8x8(ta);
 
-      template <typename T, std::size_t block_length, std::size_t row_count>
-      inline void interleave(data_block<T,block_length> (&block_stack)[row_count],
-                             const std::size_t partial_block_length)
-      {
-         if (partial_block_length == block_length)
-         {
-            interleave<T,block_length,row_count>(block_stack);
+            for (std::size_t k = 0; k < 8; ++k)
+            {
+               _mm256_storeu_si256(reinterpret_cast<__m256i*>(b[k] + b_col), ta[k]);
+            }
          }
-         else
-         {
-            data_block<T,block_length> auxiliary_stack[row_count];
 
-            std::size_t aux_row   = 0;
-            std::size_t aux_index = 0;
+         #endif
 
-            for (std::size_t index = 0; index < partial_block_length; ++index)
+         template <bool exchange, typename T>
+         inline void transpose_tiles(T* const a[], const std::size_t a_col, T* const b[], const std::size_t b_col, const std::size_t tile)
+         {
+            /*
+              Store the transpose of tile A (rows a, from column a_col) as
+              tile B (rows b, from column b_col), and when exchanging, the
+              transpose of tile B as tile A. A diagonal tile, being its own
+              mirror, is transposed in place.
+            */
+
+            #if defined(SCHIFRA_X86_DISPATCH)
+            if ((1 == transpose_traits<T>::vector_symbol_size) && (16 == tile))
             {
-               for (std::size_t row = 0; row < row_count; ++row)
-               {
-                  auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
+               transpose_tiles_ssse3<exchange>(a, a_col, b, b_col);
+               return;
+            }
+            else if ((4 == transpose_traits<T>::vector_symbol_size) && (8 == tile))
+            {
+               transpose_tiles_avx2<exchange>(a, a_col, b, b_col);
+               return;
+            }
+            #endif
 
-                  if (++aux_index == block_length)
+            if (!exchange)
+            {
+               for (std::size_t i = 0; i < tile; ++i)
+               {
+                  for (std::size_t j = 0; j < tile; ++j)
                   {
-                     aux_index = 0;
-                     aux_row++;
+                     b[j][b_col + i] = a[i][a_col + j];
                   }
                }
             }
-
-            for (std::size_t index = partial_block_length; index < block_length; ++index)
+            else if ((a == b) && (a_col == b_col))
             {
-               for (std::size_t row = 0; row < row_count - 1; ++row)
+               for (std::size_t i = 0; i < tile; ++i)
                {
-                  auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
-                  if (++aux_index == block_length)
+                  for (std::size_t j = i + 1; j < tile; ++j)
                   {
-                     aux_index = 0;
-                     aux_row++;
+                     std::swap(a[i][a_col + j], a[j][a_col + i]);
                   }
                }
             }
-
-            for (std::size_t row = 0; row < row_count - 1; ++row)
+            else
             {
-               for (std::size_t index = 0; index < block_length; ++index)
+               for (std::size_t i = 0; i < tile; ++i)
                {
-                  block_stack[row][index] = auxiliary_stack[row][index];
+                  for (std::size_t j = 0; j < tile; ++j)
+                  {
+                     std::swap(a[i][a_col + j], b[j][b_col + i]);
+                  }
                }
             }
-
-            for (std::size_t index = 0; index < partial_block_length; ++index)
-            {
-               block_stack[row_count - 1][index] = auxiliary_stack[row_count - 1][index];
-            }
          }
-      }
 
-      template <typename T, std::size_t block_length>
-      inline void interleave(data_block<T,block_length> block_stack[],
-                             const std::size_t row_count)
-      {
-         data_block<T,block_length>* auxiliary_stack = new data_block<T,block_length>[row_count];
+         template <typename T>
+         inline void transpose(T* const row[], const std::size_t size)
+         {
+            /*
+              In place transpose of the size x size symbols row[i][j], the
+              symbols beyond the last whole tile being swapped singly.
+            */
 
-         std::size_t aux_row   = 0;
-         std::size_t aux_index = 0;
+            const std::size_t tile = transpose_tile_size<T>();
+            const std::size_t full = (size / tile) * tile;
 
-         for (std::size_t index = 0; index < block_length; ++index)
-         {
-            for (std::size_t row = 0; row < row_count; ++row)
+            for (std::size_t i = 0; i < full; i += tile)
             {
-               auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
-
-               if (++aux_index == block_length)
+               for (std::size_t j = i; j < full; j += tile)
                {
-                  aux_index = 0;
-                  aux_row++;
+                  transpose_tiles<true>(row + i, j, row + j, i, tile);
                }
             }
-         }
 
-         for (std::size_t row = 0; row < row_count; ++row)
-         {
-            for (std::size_t index = 0; index < block_length; ++index)
+            for (std::size_t i = 0; i < size; ++i)
             {
-               block_stack[row][index] = auxiliary_stack[row][index];
+               for (std::size_t j = std::max(i + 1, full); j < size; ++j)
+               {
+                  std::swap(row[i][j], row[j][i]);
+               }
             }
          }
 
-         delete[] auxiliary_stack;
-      }
-
-      template <typename T, std::size_t block_length>
-      inline void interleave(data_block<T,block_length> block_stack[],
-                             const std::size_t row_count,
-                             const std::size_t partial_block_length)
-      {
-         data_block<T,block_length>* auxiliary_stack = new data_block<T,block_length>[row_count];
-
-         std::size_t aux_row   = 0;
-         std::size_t aux_index = 0;
-
-         for (std::size_t index = 0; index < partial_block_length; ++index)
+         template <typename T>
+         inline void exchange_band_tiles(T* const row[],
+                                         const std::size_t size,
+                                         const std::size_t tile,
+                                         const std::size_t i,
+                                         const std::size_t j)
          {
-            for (std::size_t row = 0; row < row_count; ++row)
-            {
-               auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
+            // Exchange the tile at (i,j) with its mirror at (j,i)
+            const std::size_t i_end = std::min(i + tile, size);
+            const std::size_t j_end = std::min(j + tile, size);
 
-               if (++aux_index == block_length)
+            if (((i_end - i) == tile) && ((j_end - j) == tile))
+            {
+               transpose_tiles<true>(row + i, j, row + j, i, tile);
+            }
+            else
+            {
+               for (std::size_t r = i; r < i_end; ++r)
                {
-                  aux_index = 0;
-                  aux_row++;
+                  for (std::size_t c = ((i == j) ? (r + 1) : j); c < j_end; ++c)
+                  {
+                     std::swap(row[r][c], row[c][r]);
+                  }
                }
             }
          }
 
-         for (std::size_t index = partial_block_length; index < block_length; ++index)
+         template <typename T, typename BandFunction>
+         inline bool transpose_by_band(T* const row[],
+                                       const std::size_t size,
+                                       BandFunction& band_function,
+                                       const bool rows_first)
          {
-            for (std::size_t row = 0; row < row_count - 1; ++row)
+            /*
+              The in place square transpose, taken a band of tile rows at a
+              time, with the rows of each band given to band_function while
+              they are in cache - hence each symbol is brought in once for
+              both the codec and the transpose.
+              rows_first: The rows of band b, untouched until then, are
+              given to band_function, and then its tiles are exchanged with
+              those of the bands before it (eg: encode, then interleave).
+              Otherwise the tiles of band b are exchanged with those of the
+              bands after it, which completes the transposed rows of band
+              b, and then these are given to band_function (eg: deinterleave,
+              then decode). Should band_function fail upon a band, the
+              remaining bands are still transposed, but no longer given to
+              it, and false is returned.
+            */
+
+            const std::size_t tile = transpose_tile_size<T>();
+
+            bool result = true;
+
+            for (std::size_t b = 0; b < size; b += tile)
             {
-               auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
+               const std::size_t b_end = std::min(b + tile, size);
 
-               if (++aux_index == block_length)
+               if (rows_first)
                {
-                  aux_index = 0;
-                  aux_row++;
+                  result = result && band_function(b, b_end);
+
+                  for (std::size_t j = 0; j <= b; j += tile)
+                  {
+                     exchange_band_tiles(row, size, tile, b, j);
+                  }
                }
-            }
-         }
+               else
+               {
+                  for (std::size_t j = b; j < size; j += tile)
+                  {
+                     exchange_band_tiles(row, size, tile, b, j);
+                  }
 
-         for (std::size_t row = 0; row < row_count - 1; ++row)
-         {
-            for (std::size_t index = 0; index < block_length; ++index)
-            {
-               block_stack[row][index] = auxiliary_stack[row][index];
+                  result = result && band_function(b, b_end);
+               }
             }
+
+            return result;
          }
 
-         for (std::size_t index = 0; index < partial_block_length; ++index)
+         template <typename Encoder, typename Block>
+         struct band_encoder
          {
-            block_stack[row_count - 1][index] = auxiliary_stack[row_count - 1][index];
-         }
+            band_encoder(const Encoder& encoder, Block* block_stack)
+            : encoder_(encoder),
+              block_stack_(block_stack)
+            {}
 
-         delete[] auxiliary_stack;
-      }
+            inline bool operator()(const std::size_t first, const std::size_t last)
+            {
+               for (std::size_t i = first; i < last; ++i)
+               {
+                  if (!encoder_.encode(block_stack_[i]))
+                     return false;
+               }
 
-      template <std::size_t code_length, std::size_t fec_length, std::size_t row_count>
-      inline void deinterleave(block<code_length,fec_length> (&block_stack)[row_count])
-      {
-         block<code_length,fec_length> auxiliary_stack[row_count];
+               return true;
+            }
 
-         std::size_t aux_row   = 0;
-         std::size_t aux_index = 0;
+            const Encoder& encoder_;
+            Block*         block_stack_;
+         };
 
-         for (std::size_t row = 0; row < row_count; ++row)
+         template <typename Decoder, typename Block>
+         struct band_decoder
          {
-            for (std::size_t index = 0; index < code_length; ++index)
-            {
-               auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
+            band_decoder(const Decoder& decoder, Block* block_stack, const erasure_locations_t& erasure_list)
+            : decoder_(decoder),
+              block_stack_(block_stack),
+              erasure_list_(erasure_list)
+            {}
 
-               if (++aux_row == row_count)
+            inline bool operator()(const std::size_t first, const std::size_t last)
+            {
+               for (std::size_t i = first; i < last; ++i)
                {
-                  aux_row = 0;
-                  aux_index++;
+                  if (!decoder_.decode(block_stack_[i], erasure_list_, workspace_))
+                     return false;
                }
+
+               return true;
             }
-         }
 
-         copy<code_length,fec_length,row_count>(auxiliary_stack,block_stack);
-      }
+            const Decoder&                decoder_;
+            Block*                        block_stack_;
+            const erasure_locations_t&    erasure_list_;
+            typename Decoder::workspace   workspace_;
+         };
 
-      template <std::size_t code_length, std::size_t fec_length, std::size_t row_count>
-      inline void deinterleave(block<code_length,fec_length> (&block_stack)[row_count],
-                               const std::size_t partial_code_length)
-      {
-         if (partial_code_length == code_length)
-         {
-            deinterleave<code_length,fec_length,row_count>(block_stack);
-         }
-         else
+         template <typename T>
+         inline void transpose(const T* const source[], const std::size_t rows, const std::size_t cols, T* const dst[])
          {
-            block<code_length,fec_length> auxiliary_stack[row_count];
+            /*
+              dst[j][i] = src[i][j], for the rows x cols symbols of src.
+              The tile kernels take mutable rows as they also exchange, but
+              the source tiles of an out-of-place transpose are only read.
+            */
 
-            std::size_t aux_row1   = 0;
-            std::size_t aux_index1 = 0;
+            T* const* src = const_cast<T* const*>(source);
 
-            std::size_t aux_row2   = 0;
-            std::size_t aux_index2 = 0;
+            const std::size_t tile      = transpose_tile_size<T>();
+            const std::size_t full_rows = (rows / tile) * tile;
+            const std::size_t full_cols = (cols / tile) * tile;
 
-            for (std::size_t i = 0; i < partial_code_length * row_count; ++i)
+            for (std::size_t i = 0; i < full_rows; i += tile)
             {
-               auxiliary_stack[aux_row1][aux_index1] = block_stack[aux_row2][aux_index2];
-
-               if (++aux_row1 == row_count)
+               for (std::size_t j = 0; j < full_cols; j += tile)
                {
-                  aux_row1 = 0;
-                  aux_index1++;
+                  transpose_tiles<false>(src + i, j, dst + j, i, tile);
                }
 
-               if (++aux_index2 == code_length)
+               for (std::size_t k = i; k < (i + tile); ++k)
                {
-                  aux_index2 = 0;
-                  aux_row2++;
+                  for (std::size_t j = full_cols; j < cols; ++j)
+                  {
+                     dst[j][k] = src[k][j];
+                  }
                }
             }
 
-            for (std::size_t i = 0; aux_index1 < code_length; ++i)
+            for (std::size_t i = full_rows; i < rows; ++i)
             {
-               auxiliary_stack[aux_row1][aux_index1] = block_stack[aux_row2][aux_index2];
-
-               if (++aux_row1 == (row_count - 1))
-               {
-                  aux_row1 = 0;
-                  aux_index1++;
-               }
-
-               if (++aux_index2 == code_length)
+               for (std::size_t j = 0; j < cols; ++j)
                {
-                  aux_index2 = 0;
-                  aux_row2++;
+                  dst[j][i] = src[i][j];
                }
             }
+         }
 
-            for (std::size_t row = 0; row < row_count - 1; ++row)
+         template <typename T>
+         inline void interleave(T* const row[],
+                                const std::size_t row_count,
+                                const std::size_t length,
+                                T buffer[],
+                                T* buffer_row[])
+         {
+            /*
+              The symbols of the rows, taken column by column, are laid back
+              across the rows in order. Being the transpose of the stack
+              (into length x row_count) followed by a sequential copy. The
+              buffer is of row_count * length symbols, and buffer_row of
+              length rows.
+            */
+
+            for (std::size_t i = 0; i < length; ++i)
             {
-               for (std::size_t index = 0; index < code_length; ++index)
-               {
-                  block_stack[row][index] = auxiliary_stack[row][index];
-               }
+               buffer_row[i] = buffer + (i * row_count);
             }
 
-            for (std::size_t index = 0; index < partial_code_length; ++index)
+            transpose(row, row_count, length, buffer_row);
+
+            for (std::size_t i = 0; i < row_count; ++i)
             {
-               block_stack[row_count - 1][index] = auxiliary_stack[row_count - 1][index];
+               std::copy(buffer + (i * length), buffer + ((i + 1) * length), row[i]);
             }
          }
-      }
-
-      template <typename T, std::size_t block_length>
-      inline void deinterleave(data_block<T,block_length> (&block_stack)[block_length])
-      {
-         data_block<T,block_length> auxiliary_stack[block_length];
 
-         for (std::size_t row = 0; row < block_length; ++row)
+         template <typename T>
+         inline void deinterleave(T* const row[],
+                                  const std::size_t row_count,
+                                  const std::size_t length,
+                                  T buffer[],
+                                  T* buffer_row[])
          {
-            for (std::size_t index = 0; index < block_length; ++index)
+            // The inverse of interleave
+            for (std::size_t i = 0; i < row_count; ++i)
             {
-               auxiliary_stack[index][row] = block_stack[row][index];
+               std::copy(row[i], row[i] + length, buffer + (i * length));
             }
-         }
 
-         copy<T,block_length,block_length>(auxiliary_stack,block_stack);
-      }
+            for (std::size_t i = 0; i < length; ++i)
+            {
+               buffer_row[i] = buffer + (i * row_count);
+            }
 
-      template <typename T, std::size_t block_length, std::size_t row_count>
-      inline void deinterleave(data_block<T,block_length> (&block_stack)[row_count])
-      {
-         data_block<T,block_length> auxiliary_stack[row_count];
+            transpose(buffer_row, length, row_count, row);
+         }
 
-         std::size_t aux_row   = 0;
-         std::size_t aux_index = 0;
+         template <typename T>
+         inline void interleave(T* const row[], const std::size_t row_count, const std::size_t length)
+         {
+            // Stacks whose row count is only known at runtime have their buffer on the heap
+            std::vector<T>  buffer(row_count * length);
+            std::vector<T*> buffer_row(length);
+
+            interleave(row, row_count, length, &buffer[0], &buffer_row[0]);
+         }
 
-         for (std::size_t row = 0; row < row_count; ++row)
+         template <typename T>
+         inline void deinterleave(T* const row[], const std::size_t row_count, const std::size_t length)
          {
-            for (std::size_t index = 0; index < block_length; ++index)
-            {
-               auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
+            std::vector<T>  buffer(row_count * length);
+            std::vector<T*> buffer_row(length);
 
-               if (++aux_row == row_count)
-               {
-                  aux_row = 0;
-                  aux_index++;
-               }
-            }
+            deinterleave(row, row_count, length, &buffer[0], &buffer_row[0]);
          }
 
-         copy<T,block_length,row_count>(auxiliary_stack,block_stack);
-      }
+         template <std::size_t row_count, std::size_t length, typename T>
+         inline void interleave(T* const row[])
+         {
+            // Stacks of compile time dimensions have their buffer on the stack
+            T  buffer[row_count * length];
+            T* buffer_row[length];
 
-      template <typename T, std::size_t block_length>
-      inline void deinterleave(data_block<T,block_length> block_stack[],
-                               const std::size_t row_count)
-      {
-         data_block<T,block_length>* auxiliary_stack = new data_block<T,block_length>[row_count];
+            interleave(row, row_count, length, buffer, buffer_row);
+         }
+
+         template <std::size_t row_count, std::size_t length, typename T>
+         inline void deinterleave(T* const row[])
+         {
+            T  buffer[row_count * length];
+            T* buffer_row[length];
 
-         std::size_t aux_row   = 0;
-         std::size_t aux_index = 0;
+            deinterleave(row, row_count, length, buffer, buffer_row);
+         }
 
-         for (std::size_t row = 0; row < row_count; ++row)
+         template <bool gather, typename T>
+         inline void reshape(T* const stack[],
+                             T* const flat[],
+                             const std::size_t flat_length,
+                             const std::size_t row_count,
+                             const std::size_t begin,
+                             const std::size_t end,
+                             const std::size_t flat_begin)
          {
-            for (std::size_t index = 0; index < block_length; ++index)
+            /*
+              The symbols [begin,end) of the stack's first row_count rows are
+              taken column by column, and laid out in order across the rows
+              (each of flat_length symbols) of flat, from position flat_begin
+              - or when gathering, the reverse. Used for the partial stacks,
+              whose last row is short.
+            */
+
+            std::size_t flat_row   = flat_begin / flat_length;
+            std::size_t flat_index = flat_begin % flat_length;
+
+            for (std::size_t index = begin; index < end; ++index)
             {
-               auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
-
-               if (++aux_row == row_count)
+               for (std::size_t row = 0; row < row_count; ++row)
                {
-                  aux_row = 0;
-                  aux_index++;
+                  if (gather)
+                     stack[row][index] = flat[flat_row][flat_index];
+                  else
+                     flat[flat_row][flat_index] = stack[row][index];
+
+                  if (++flat_index == flat_length)
+                  {
+                     flat_index = 0;
+                     ++flat_row;
+                  }
                }
             }
          }
 
-         for (std::size_t row = 0; row < row_count; ++row)
+         template <typename T>
+         inline void interleave_to(const T* const source[],
+                                   const std::size_t row_count,
+                                   const std::size_t length,
+                                   T* const destination[],
+                                   const std::size_t destination_length)
          {
-            for (std::size_t index = 0; index < block_length; ++index)
-            {
-               block_stack[row][index] = auxiliary_stack[row][index];
-            }
+            /*
+              The interleaved order of the source rows, written across the
+              destination rows (each of destination_length symbols) in one
+              pass. When the destination rows are row_count symbols long,
+              each holds exactly one column of the source, and the tiled
+              transpose applies.
+            */
+
+            if (destination_length == row_count)
+               transpose(source, row_count, length, destination);
+            else
+               reshape<false>(const_cast<T* const*>(source), destination, destination_length, row_count, 0, length, 0);
          }
 
-         delete[] auxiliary_stack;
-      }
-
-      template <typename T, std::size_t block_length>
-      inline void deinterleave(data_block<T,block_length> block_stack[],
-                               const std::size_t row_count,
-                               const std::size_t partial_block_length)
-      {
-         if (row_count == 1) return;
-
-         data_block<T,block_length>* auxiliary_stack = new data_block<T,block_length>[row_count];
-
-         std::size_t aux_row1   = 0;
-         std::size_t aux_index1 = 0;
-
-         std::size_t aux_row2   = 0;
-         std::size_t aux_index2 = 0;
-
-         for (std::size_t i = 0; i < partial_block_length * row_count; ++i)
+         template <typename T>
+         inline void deinterleave_from(const T* const source[],
+                                       const std::size_t source_length,
+                                       const std::size_t row_count,
+                                       const std::size_t length,
+                                       T* const destination[])
          {
-            auxiliary_stack[aux_row1][aux_index1] = block_stack[aux_row2][aux_index2];
-
-            if (++aux_row1 == row_count)
-            {
-               aux_row1 = 0;
-               aux_index1++;
-            }
-
-            if (++aux_index2 == block_length)
-            {
-               aux_index2 = 0;
-               aux_row2++;
-            }
+            // The inverse of interleave_to
+            if (source_length == row_count)
+               transpose(source, length, row_count, destination);
+            else
+               reshape<true>(destination, const_cast<T* const*>(source), source_length, row_count, 0, length, 0);
          }
 
-         for (std::size_t i = 0; aux_index1 < block_length; ++i)
+         template <typename T>
+         inline std::vector<T*> buffer_rows(T* buffer, const std::size_t row_count, const std::size_t length)
          {
-            auxiliary_stack[aux_row1][aux_index1] = block_stack[aux_row2][aux_index2];
+            std::vector<T*> row(row_count);
 
-            if (++aux_row1 == (row_count - 1))
+            for (std::size_t i = 0; i < row_count; ++i)
             {
-               aux_row1 = 0;
-               aux_index1++;
+               row[i] = buffer + (i * length);
             }
 
-            if (++aux_index2 == block_length)
-            {
-               aux_index2 = 0;
-               aux_row2++;
-            }
+            return row;
          }
 
-         for (std::size_t row = 0; row < row_count - 1; ++row)
-         {
-            for (std::size_t index = 0; index < block_length; ++index)
-            {
-               block_stack[row][index] = auxiliary_stack[row][index];
-            }
-         }
+      } // namespace details
+
+      template <std::size_t code_length, std::size_t fec_length>
+      inline void interleave(block<code_length,fec_length> (&block_stack)[code_length])
+      {
+         typename block<code_length,fec_length>::symbol_type* row[code_length];
 
-         for (std::size_t index = 0; index < partial_block_length; ++index)
+         for (std::size_t i = 0; i < code_length; ++i)
          {
-            block_stack[row_count - 1][index] = auxiliary_stack[row_count - 1][index];
+            row[i] = block_stack[i].data;
          }
 
-         delete[] auxiliary_stack;
+         details::transpose(row, code_length);
       }
 
-      template <typename T, std::size_t block_length, std::size_t skip_columns>
-      inline void interleave_columnskip(data_block<T,block_length>* block_stack)
+      template <std::size_t code_length, std::size_t fec_length, std::size_t row_count>
+      inline void interleave(block<code_length,fec_length> (&block_stack)[row_count])
+      {
+         typename block<code_length,fec_length>::symbol_type* row[row_count];
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            row[i] = block_stack[i].data;
+         }
+
+         details::interleave<row_count,code_length>(row);
+      }
+
+      template <typename Encoder, std::size_t code_length, std::size_t fec_length, std::size_t data_length, typename T>
+      inline bool encode_and_interleave(const Encoder& encoder,
+                                        block<code_length,fec_length,data_length,T> (&block_stack)[code_length])
+      {
+         /*
+           Encode each row of the square stack and interleave the stack, in
+           one pass over the symbols rather than an encoding pass followed
+           by a transpose pass. The result is as encoding every row then
+           calling interleave.
+         */
+
+         T* row[code_length];
+
+         for (std::size_t i = 0; i < code_length; ++i)
+         {
+            row[i] = block_stack[i].data;
+         }
+
+         details::band_encoder<Encoder,block<code_length,fec_length,data_length,T> > band_encoder(encoder, block_stack);
+
+         return details::transpose_by_band(row, code_length, band_encoder, true);
+      }
+
+      template <typename Decoder, std::size_t code_length, std::size_t fec_length, std::size_t data_length, typename T>
+      inline bool deinterleave_and_decode(const Decoder& decoder,
+                                          block<code_length,fec_length,data_length,T> (&block_stack)[code_length],
+                                          const erasure_locations_t& erasure_list)
+      {
+         /*
+           Deinterleave the square stack and decode each of its rows, with
+           the given erasures, in one pass over the symbols. The result is
+           as calling deinterleave then decoding every row - upon failure
+           the stack is still wholly deinterleaved.
+         */
+
+         T* row[code_length];
+
+         for (std::size_t i = 0; i < code_length; ++i)
+         {
+            row[i] = block_stack[i].data;
+         }
+
+         details::band_decoder<Decoder,block<code_length,fec_length,data_length,T> > band_decoder(decoder, block_stack, erasure_list);
+
+         return details::transpose_by_band(row, code_length, band_decoder, false);
+      }
+
+      template <std::size_t code_length, std::size_t fec_length, std::size_t row_count>
+      inline void interleave(block<code_length,fec_length> (&block_stack)[row_count],
+                             const std::size_t partial_code_length)
       {
+         /*
+           The last row holds only partial_code_length symbols, hence the
+           columns beyond it are taken from the preceding rows only.
+         */
+
+         if (partial_code_length == code_length)
+         {
+            interleave<code_length,fec_length,row_count>(block_stack);
+         }
+         else
+         {
+            typedef typename block<code_length,fec_length>::symbol_type symbol_type;
+
+            block<code_length,fec_length> auxiliary_stack[row_count];
+
+            symbol_type* row    [row_count];
+            symbol_type* aux_row[row_count];
+
+            for (std::size_t i = 0; i < row_count; ++i)
+            {
+               row    [i] = block_stack    [i].data;
+               aux_row[i] = auxiliary_stack[i].data;
+            }
+
+            details::reshape<false>(row, aux_row, code_length, row_count    , 0, partial_code_length, 0);
+            details::reshape<false>(row, aux_row, code_length, row_count - 1, partial_code_length, code_length, partial_code_length * row_count);
+
+            for (std::size_t row = 0; row < row_count - 1; ++row)
+            {
+               for (std::size_t index = 0; index < code_length; ++index)
+               {
+                  block_stack[row][index] = auxiliary_stack[row][index];
+               }
+            }
+
+            for (std::size_t index = 0; index < partial_code_length; ++index)
+            {
+               block_stack[row_count - 1][index] = auxiliary_stack[row_count - 1][index];
+            }
+         }
+      }
+
+      template <typename T, std::size_t block_length>
+      inline void interleave(data_block<T,block_length> (&block_stack)[block_length])
+      {
+         T* row[block_length];
+
          for (std::size_t i = 0; i < block_length; ++i)
          {
-            for (std::size_t j = i + 1; j < block_length; ++j)
+            row[i] = block_stack[i].begin();
+         }
+
+         details::transpose(row, block_length);
+      }
+
+      template <typename T, std::size_t block_length, std::size_t row_count>
+      inline void interleave(data_block<T,block_length> (&block_stack)[row_count])
+      {
+         T* row[row_count];
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            row[i] = block_stack[i].begin();
+         }
+
+         details::interleave<row_count,block_length>(row);
+      }
+
+      template <typename T, std::size_t block_length, std::size_t row_count>
+      inline void interleave(data_block<T,block_length> (&block_stack)[row_count],
+                             const std::size_t partial_block_length)
+      {
+         if (partial_block_length == block_length)
+         {
+            interleave<T,block_length,row_count>(block_stack);
+         }
+         else
+         {
+            interleave<T,block_length>(&block_stack[0], row_count, partial_block_length);
+         }
+      }
+
+      template <typename T, std::size_t block_length>
+      inline void interleave(data_block<T,block_length> block_stack[],
+                             const std::size_t row_count)
+      {
+         std::vector<T*> row(row_count);
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            row[i] = block_stack[i].begin();
+         }
+
+         details::interleave(&row[0], row_count, block_length);
+      }
+
+      template <typename T, std::size_t block_length>
+      inline void interleave(data_block<T,block_length> block_stack[],
+                             const std::size_t row_count,
+                             const std::size_t partial_block_length)
+      {
+         /*
+           The last row holds only partial_block_length symbols, hence the
+           columns beyond it are taken from the preceding rows only.
+         */
+
+         std::vector<data_block<T,block_length> > auxiliary_stack(row_count);
+
+         std::vector<T*> row    (row_count);
+         std::vector<T*> aux_row(row_count);
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            row    [i] = block_stack    [i].begin();
+            aux_row[i] = auxiliary_stack[i].begin();
+         }
+
+         details::reshape<false>(&row[0], &aux_row[0], block_length, row_count    , 0, partial_block_length, 0);
+         details::reshape<false>(&row[0], &aux_row[0], block_length, row_count - 1, partial_block_length, block_length, partial_block_length * row_count);
+
+         for (std::size_t i = 0; i < row_count - 1; ++i)
+         {
+            std::copy(auxiliary_stack[i].begin(), auxiliary_stack[i].end(), block_stack[i].begin());
+         }
+
+         std::copy(auxiliary_stack[row_count - 1].begin(),
+                   auxiliary_stack[row_count - 1].begin() + partial_block_length,
+                   block_stack[row_count - 1].begin());
+      }
+
+      template <std::size_t code_length, std::size_t fec_length, std::size_t row_count>
+      inline void deinterleave(block<code_length,fec_length> (&block_stack)[row_count])
+      {
+         typename block<code_length,fec_length>::symbol_type* row[row_count];
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            row[i] = block_stack[i].data;
+         }
+
+         details::deinterleave<row_count,code_length>(row);
+      }
+
+      template <std::size_t code_length, std::size_t fec_length, std::size_t row_count>
+      inline void deinterleave(block<code_length,fec_length> (&block_stack)[row_count],
+                               const std::size_t partial_code_length)
+      {
+         if (partial_code_length == code_length)
+         {
+            deinterleave<code_length,fec_length,row_count>(block_stack);
+         }
+         else
+         {
+            typedef typename block<code_length,fec_length>::symbol_type symbol_type;
+
+            block<code_length,fec_length> auxiliary_stack[row_count];
+
+            symbol_type* row    [row_count];
+            symbol_type* aux_row[row_count];
+
+            for (std::size_t i = 0; i < row_count; ++i)
             {
-               std::size_t x1 = i + skip_columns;
-               std::size_t x2 = j + skip_columns;
+               row    [i] = block_stack    [i].data;
+               aux_row[i] = auxiliary_stack[i].data;
+            }
+
+            details::reshape<true>(aux_row, row, code_length, row_count    , 0, partial_code_length, 0);
+            details::reshape<true>(aux_row, row, code_length, row_count - 1, partial_code_length, code_length, partial_code_length * row_count);
 
-               T tmp = block_stack[i][x2];
-               block_stack[i][x2] = block_stack[j][x1];
-               block_stack[j][x1] = tmp;
+            for (std::size_t row = 0; row < row_count - 1; ++row)
+            {
+               for (std::size_t index = 0; index < code_length; ++index)
+               {
+                  block_stack[row][index] = auxiliary_stack[row][index];
+               }
+            }
+
+            for (std::size_t index = 0; index < partial_code_length; ++index)
+            {
+               block_stack[row_count - 1][index] = auxiliary_stack[row_count - 1][index];
             }
          }
       }
 
+      template <typename T, std::size_t block_length>
+      inline void deinterleave(data_block<T,block_length> (&block_stack)[block_length])
+      {
+         // A square stack's transpose is its own inverse
+         interleave<T,block_length>(block_stack);
+      }
+
+      template <typename T, std::size_t block_length, std::size_t row_count>
+      inline void deinterleave(data_block<T,block_length> (&block_stack)[row_count])
+      {
+         T* row[row_count];
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            row[i] = block_stack[i].begin();
+         }
+
+         details::deinterleave<row_count,block_length>(row);
+      }
+
+      template <typename T, std::size_t block_length>
+      inline void deinterleave(data_block<T,block_length> block_stack[],
+                               const std::size_t row_count)
+      {
+         std::vector<T*> row(row_count);
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            row[i] = block_stack[i].begin();
+         }
+
+         details::deinterleave(&row[0], row_count, block_length);
+      }
+
+      template <typename T, std::size_t block_length>
+      inline void deinterleave(data_block<T,block_length> block_stack[],
+                               const std::size_t row_count,
+                               const std::size_t partial_block_length)
+      {
+         if (row_count == 1) return;
+
+         std::vector<data_block<T,block_length> > auxiliary_stack(row_count);
+
+         std::vector<T*> row    (row_count);
+         std::vector<T*> aux_row(row_count);
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            row    [i] = block_stack    [i].begin();
+            aux_row[i] = auxiliary_stack[i].begin();
+         }
+
+         details::reshape<true>(&aux_row[0], &row[0], block_length, row_count    , 0, partial_block_length, 0);
+         details::reshape<true>(&aux_row[0], &row[0], block_length, row_count - 1, partial_block_length, block_length, partial_block_length * row_count);
+
+         for (std::size_t i = 0; i < row_count - 1; ++i)
+         {
+            std::copy(auxiliary_stack[i].begin(), auxiliary_stack[i].end(), block_stack[i].begin());
+         }
+
+         std::copy(auxiliary_stack[row_count - 1].begin(),
+                   auxiliary_stack[row_count - 1].begin() + partial_block_length,
+                   block_stack[row_count - 1].begin());
+      }
+
+      template <typename T, std::size_t block_length, std::size_t skip_columns>
+      inline void interleave_columnskip(data_block<T,block_length>* block_stack)
+      {
+         T* row[block_length];
+
+         for (std::size_t i = 0; i < block_length; ++i)
+         {
+            row[i] = block_stack[i].begin() + skip_columns;
+         }
+
+         details::transpose(row, block_length);
+      }
+
       template <typename T, std::size_t block_length, std::size_t skip_columns>
       inline void interleave_columnskip(data_block<T,block_length>* block_stack, const std::size_t& row_count)
       {
-         data_block<T,block_length>* auxiliary_stack = new data_block<T,block_length>[row_count];
+         std::vector<T*> row(row_count);
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            row[i] = block_stack[i].begin() + skip_columns;
+         }
+
+         details::interleave(&row[0], row_count, block_length - skip_columns);
+      }
+
+      template <typename T, std::size_t data_length>
+      inline void interleave(T* block_stack[data_length])
+      {
+         details::transpose(block_stack, data_length);
+      }
+
+      template <typename T, std::size_t data_length, std::size_t skip_columns>
+      inline void interleave_columnskip(T* block_stack[data_length])
+      {
+         T* row[data_length - skip_columns];
+
+         for (std::size_t i = 0; i < (data_length - skip_columns); ++i)
+         {
+            row[i] = block_stack[skip_columns + i] + skip_columns;
+         }
+
+         details::transpose(row, data_length - skip_columns);
+      }
+
+      /*
+        Out-of-place interleaving: the source is left as is, and the
+        interleaved symbols are written straight into the destination -
+        being either one buffer of row_count * length symbols, or row_count
+        buffers (eg: packets) of length symbols each, which is the layout
+        of the in-place interleaved stack. Deinterleaving is the inverse.
+        The transpose and the copy into (or out of) the output buffers are
+        thereby one pass over the symbols.
+      */
+
+      template <typename T>
+      inline void interleave_to(const T* source,
+                                const std::size_t row_count,
+                                const std::size_t length,
+                                      T* destination)
+      {
+         const std::vector<const T*> source_row      = details::buffer_rows(source, row_count, length);
+         const std::vector<T*>       destination_row = details::buffer_rows(destination, length, row_count);
+
+         details::interleave_to(&source_row[0], row_count, length, &destination_row[0], row_count);
+      }
+
+      template <typename T, std::size_t block_length>
+      inline void interleave_to(const data_block<T,block_length> source[],
+                                const std::size_t row_count,
+                                      T* destination)
+      {
+         std::vector<const T*> source_row(row_count);
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            source_row[i] = source[i].begin();
+         }
+
+         const std::vector<T*> destination_row = details::buffer_rows(destination, block_length, row_count);
+
+         details::interleave_to(&source_row[0], row_count, block_length, &destination_row[0], row_count);
+      }
+
+      template <typename T, std::size_t block_length>
+      inline void interleave_to(const data_block<T,block_length> source[],
+                                const std::size_t row_count,
+                                      T* const destination[])
+      {
+         std::vector<const T*> source_row(row_count);
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            source_row[i] = source[i].begin();
+         }
+
+         details::interleave_to(&source_row[0], row_count, block_length, destination, block_length);
+      }
+
+      template <std::size_t code_length, std::size_t fec_length, std::size_t data_length, typename T>
+      inline void interleave_to(const block<code_length,fec_length,data_length,T> source[],
+                                const std::size_t row_count,
+                                      T* const destination[])
+      {
+         std::vector<const T*> source_row(row_count);
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            source_row[i] = source[i].data;
+         }
+
+         details::interleave_to(&source_row[0], row_count, code_length, destination, code_length);
+      }
+
+      template <typename T>
+      inline void deinterleave_from(const T* source,
+                                    const std::size_t row_count,
+                                    const std::size_t length,
+                                          T* destination)
+      {
+         const std::vector<const T*> source_row      = details::buffer_rows(source, length, row_count);
+         const std::vector<T*>       destination_row = details::buffer_rows(destination, row_count, length);
+
+         details::deinterleave_from(&source_row[0], row_count, row_count, length, &destination_row[0]);
+      }
+
+      template <typename T, std::size_t block_length>
+      inline void deinterleave_from(const T* source,
+                                    const std::size_t row_count,
+                                          data_block<T,block_length> destination[])
+      {
+         const std::vector<const T*> source_row = details::buffer_rows(source, block_length, row_count);
+
+         std::vector<T*> destination_row(row_count);
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            destination_row[i] = destination[i].begin();
+         }
+
+         details::deinterleave_from(&source_row[0], row_count, row_count, block_length, &destination_row[0]);
+      }
+
+      template <typename T, std::size_t block_length>
+      inline void deinterleave_from(const T* const source[],
+                                    const std::size_t row_count,
+                                          data_block<T,block_length> destination[])
+      {
+         std::vector<T*> destination_row(row_count);
+
+         for (std::size_t i = 0; i < row_count; ++i)
+         {
+            destination_row[i] = destination[i].begin();
+         }
+
+         details::deinterleave_from(source, block_length, row_count, block_length, &destination_row[0]);
+      }
 
-         std::size_t aux_row   = 0;
-         std::size_t aux_index = skip_columns;
+      template <std::size_t code_length, std::size_t fec_length, std::size_t data_length, typename T>
+      inline void deinterleave_from(const T* const source[],
+                                    const std::size_t row_count,
+                                          block<code_length,fec_length,data_length,T> destination[])
+      {
+         std::vector<T*> destination_row(row_count);
 
-         for (std::size_t index = skip_columns; index < block_length; ++index)
+         for (std::size_t i = 0; i < row_count; ++i)
          {
-            for (std::size_t row = 0; row < row_count; ++row)
+            destination_row[i] = destination[i].data;
+         }
+
+         details::deinterleave_from(source, code_length, row_count, code_length, &destination_row[0]);
+      }
+
+      /*
+        Algebraic interleavers: permutations of the symbol positions of a
+        buffer of size symbols that compute the permuted position (and its
+        inverse) of any index, rather than moving the symbols of a stack.
+        Symbol i of the uninterleaved sequence is found at position
+        permutation(i) of the interleaved buffer, hence the codewords may
+        be encoded and decoded in place at their interleaved positions by
+        way of permuted_block_view - with no stack, however deep the
+        interleaver.
+      */
+
+      class block_permutation
+      {
+      public:
+
+         /*
+           The standard block interleaver expressed as an index mapping:
+           symbol j of row i of a row_count x length stack is placed at
+           j * row_count + i, being the layout interleave_to produces.
+         */
+
+         block_permutation(const std::size_t row_count, const std::size_t length)
+         : row_count_(row_count),
+           length_(length)
+         {}
+
+         inline bool valid() const
+         {
+            return (0 < row_count_) && (0 < length_);
+         }
+
+         inline std::size_t size() const
+         {
+            return row_count_ * length_;
+         }
+
+         inline std::size_t operator()(const std::size_t index) const
+         {
+            return (index % length_) * row_count_ + (index / length_);
+         }
+
+         inline std::size_t inverse(const std::size_t position) const
+         {
+            return (position % row_count_) * length_ + (position / row_count_);
+         }
+
+      private:
+
+         std::size_t row_count_;
+         std::size_t length_;
+      };
+
+      class linear_permutation
+      {
+      public:
+
+         /*
+           The linear congruential permutation: i -> (a * i + b) mod size,
+           a bijection for any multiplier a coprime with size. Consecutive
+           symbols are placed a positions apart, so a multiplier near the
+           golden section of size (the default) spreads every run of
+           symbols, both near and far, evenly across the buffer.
+           Note: size must be less than 2^32 so that the products fit.
+         */
+
+         explicit linear_permutation(const std::size_t size)
+         : size_(size),
+           multiplier_(0),
+           offset_(0),
+           inverse_multiplier_(0)
+         {
+            if (size_ > 1)
             {
-               auxiliary_stack[aux_row][aux_index] = block_stack[row][index];
+               std::size_t multiplier = static_cast<std::size_t>(static_cast<double>(size_) * 0.6180339887);
 
-               if (++aux_index == block_length)
+               while (1 != gcd(multiplier, size_))
                {
-                  aux_index = skip_columns;
-                  aux_row++;
+                  ++multiplier;
                }
+
+               set(multiplier, 0);
             }
+            else if (1 == size_)
+               set(1, 0);
          }
 
-         for (std::size_t row = 0; row < row_count; ++row)
+         linear_permutation(const std::size_t size, const std::size_t multiplier, const std::size_t offset)
+         : size_(size),
+           multiplier_(0),
+           offset_(0),
+           inverse_multiplier_(0)
          {
-            for (std::size_t index = skip_columns; index < block_length; ++index)
+            if ((0 < size_) && (1 == gcd(multiplier % size_, size_)))
             {
-               block_stack[row][index] = auxiliary_stack[row][index];
+               set(multiplier, offset);
             }
          }
 
-         delete[] auxiliary_stack;
-      }
+         inline bool valid() const
+         {
+            return (0 != multiplier_);
+         }
 
-      template <typename T, std::size_t data_length>
-      inline void interleave(T* block_stack[data_length])
-      {
-         for (std::size_t i = 0; i < data_length; ++i)
+         inline std::size_t size() const
+         {
+            return size_;
+         }
+
+         inline std::size_t multiplier() const
+         {
+            return multiplier_;
+         }
+
+         inline std::size_t operator()(const std::size_t index) const
+         {
+            return (multiplier_ * index + offset_) % size_;
+         }
+
+         inline std::size_t inverse(const std::size_t position) const
+         {
+            return (inverse_multiplier_ * ((position + size_ - offset_) % size_)) % size_;
+         }
+
+      private:
+
+         inline void set(const std::size_t multiplier, const std::size_t offset)
          {
-            for (std::size_t j = i + 1; j < data_length; ++j)
+            multiplier_ = multiplier % size_;
+            offset_     = offset     % size_;
+
+            if (1 == size_)
             {
-               T tmp = block_stack[i][j];
-               block_stack[i][j] = block_stack[j][i];
-               block_stack[j][i] = tmp;
+               multiplier_         = 1;
+               inverse_multiplier_ = 1;
+               return;
             }
+
+            /*
+              The inverse of the multiplier modulo size, by way of the
+              extended Euclidean algorithm.
+            */
+
+            long long r0 = static_cast<long long>(size_);
+            long long r1 = static_cast<long long>(multiplier_);
+            long long t0 = 0;
+            long long t1 = 1;
+
+            while (0 != r1)
+            {
+               const long long q = r0 / r1;
+               long long temp;
+
+               temp = r0 - q * r1; r0 = r1; r1 = temp;
+               temp = t0 - q * t1; t0 = t1; t1 = temp;
+            }
+
+            if (t0 < 0)
+            {
+               t0 += static_cast<long long>(size_);
+            }
+
+            inverse_multiplier_ = static_cast<std::size_t>(t0);
          }
-      }
 
-      template <typename T, std::size_t data_length, std::size_t skip_columns>
-      inline void interleave_columnskip(T* block_stack[data_length])
-      {
-         for (std::size_t i = skip_columns; i < data_length; ++i)
+         static inline std::size_t gcd(std::size_t a, std::size_t b)
          {
-            for (std::size_t j = i + 1; j < data_length; ++j)
+            while (0 != b)
             {
-               T tmp = block_stack[i][j];
-               block_stack[i][j] = block_stack[j][i];
-               block_stack[j][i] = tmp;
+               const std::size_t r = a % b;
+               a = b;
+               b = r;
             }
+
+            return a;
+         }
+
+         std::size_t size_;
+         std::size_t multiplier_;
+         std::size_t offset_;
+         std::size_t inverse_multiplier_;
+      };
+
+      template <typename Permutation, typename T>
+      inline void interleave_to(const Permutation& permutation, const T source[], T destination[])
+      {
+         for (std::size_t i = 0; i < permutation.size(); ++i)
+         {
+            destination[permutation(i)] = source[i];
+         }
+      }
+
+      template <typename Permutation, typename T>
+      inline void deinterleave_from(const Permutation& permutation, const T source[], T destination[])
+      {
+         for (std::size_t i = 0; i < permutation.size(); ++i)
+         {
+            destination[i] = source[permutation(i)];
          }
       }
 
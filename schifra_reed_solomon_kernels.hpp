@@ -0,0 +1,942 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+#ifndef INCLUDE_SCHIFRA_REED_SOLOMON_KERNELS_HPP
+#define INCLUDE_SCHIFRA_REED_SOLOMON_KERNELS_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "schifra_cpu_features.hpp"
+#include "schifra_galois_field.hpp"
+#include "schifra_galois_field_region.hpp"
+
+
+namespace schifra
+{
+
+   namespace reed_solomon
+   {
+
+      namespace details
+      {
+
+         /*
+           Vectorised counterparts of the encoder's LFSR, the decoder's
+           syndrome computation and the Chien search, for codes over fields
+           of up to 2^8 elements. They are only ever used in place of the
+           scalar kernels of the encoder and decoder cores, when valid for
+           the code and the cpu level is above scalar - their results being
+           identical to those of the scalar kernels.
+         */
+
+         class remainder_kernel
+         {
+         public:
+
+            /*
+              Computes R(x) = (r(x) * x^fec_length) mod g(x), the input
+              r(x) being input_length symbols, highest order term first,
+              and g(x) the monic polynomial given by its feedback table
+              (feedback[k] = g[fec_length - 1 - k]). The LFSR feeding back
+              one symbol at a time is a serial chain, hence the input is
+              split into segment_count segments whose remainders are
+              computed in interleaved, independent chains, then combined:
+
+                 R(x) = sum(rem_s(x) * x^shift_s) mod g(x)
+
+              Each remainder symbol rem_s[j] contributes a fixed vector,
+              (x^(fec_length - 1 - j + shift_s) mod g(x)), scaled by it.
+              These combining vectors may be transformed by a fixed matrix
+              - the decoder maps them onto the evaluations of r(x) at the
+              generator's roots, which are the syndromes.
+            */
+
+            enum
+            {
+               segment_count    =   4,
+               max_fec_length   =  64,
+               max_input_length = 256,
+               stride           =  64
+            };
+
+            remainder_kernel(const galois::region_multiplier& multiplier,
+                             const std::size_t                fec_length,
+                             const std::size_t                input_length,
+                             const galois::field_symbol       feedback[])
+            : multiplier_(multiplier),
+              valid_(
+                      (cpu::scalar != multiplier.level()) &&
+                      (multiplier.valid())                &&
+                      (0 < fec_length)                    &&
+                      (fec_length <= max_fec_length)      &&
+                      (0 < input_length)                  &&
+                      (input_length < max_input_length)
+                    ),
+              fec_length_(fec_length),
+              input_length_(input_length),
+              segment_length_((input_length + segment_count - 1) / segment_count),
+              padding_((segment_count * segment_length_) - input_length)
+            {
+               if (!valid_)
+                  return;
+
+               feedback_.resize(3 * stride, 0);
+
+               for (std::size_t k = 0; k < fec_length_; ++k)
+               {
+                  feedback_[k] = static_cast<unsigned char>(feedback[k]);
+               }
+
+               split(&feedback_[0]);
+
+               combine_.resize(segment_count * fec_length_ * 3 * stride, 0);
+
+               for (std::size_t s = 0; s < segment_count; ++s)
+               {
+                  const std::size_t shift = (segment_count - 1 - s) * segment_length_;
+
+                  // x^shift mod g(x), as the vector of j = fec_length - 1
+                  std::vector<unsigned char> v(fec_length_, 0);
+
+                  v[fec_length_ - 1] = 1;
+
+                  for (std::size_t i = 0; i < shift; ++i)
+                  {
+                     multiply_by_x(v);
+                  }
+
+                  for (std::size_t j = fec_length_; j > 0; --j)
+                  {
+                     std::copy(v.begin(), v.end(), combine_vector(s, j - 1));
+                     multiply_by_x(v);
+                  }
+               }
+
+               for (std::size_t i = 0; i < (segment_count * fec_length_); ++i)
+               {
+                  split(&combine_[i * 3 * stride]);
+               }
+            }
+
+            inline bool valid() const
+            {
+               return valid_;
+            }
+
+            void transform(const std::vector<galois::field_symbol>& matrix)
+            {
+               /*
+                 Replace every combining vector v by v * matrix, matrix
+                 being fec_length x fec_length in row major order, so the
+                 kernel's output becomes R * matrix.
+               */
+
+               if (!valid_)
+                  return;
+
+               std::vector<unsigned char> v(fec_length_);
+
+               for (std::size_t i = 0; i < (segment_count * fec_length_); ++i)
+               {
+                  unsigned char* vector = &combine_[i * 3 * stride];
+
+                  std::fill(v.begin(), v.end(), static_cast<unsigned char>(0));
+
+                  for (std::size_t j = 0; j < fec_length_; ++j)
+                  {
+                     for (std::size_t k = 0; k < fec_length_; ++k)
+                     {
+                        v[k] ^= multiplier_.mul(vector[j], static_cast<unsigned char>(matrix[(j * fec_length_) + k]));
+                     }
+                  }
+
+                  std::copy(v.begin(), v.end(), vector);
+                  split(vector);
+               }
+            }
+
+            template <typename Codeword>
+            inline bool compute(const Codeword& input, unsigned char output[]) const
+            {
+               /*
+                 Returns false, with a zero output, when r(x) is a multiple
+                 of g(x) - ie: all the segment remainders are zero.
+               */
+
+               unsigned char buffer[max_input_length];
+
+               std::fill_n(buffer, padding_, static_cast<unsigned char>(0));
+
+               for (std::size_t i = 0; i < input_length_; ++i)
+               {
+                  buffer[padding_ + i] = static_cast<unsigned char>(input[i]);
+               }
+
+               #if defined(SCHIFRA_X86_DISPATCH)
+               const std::size_t vectors16 = (fec_length_ + 15) / 16;
+               const std::size_t vectors32 = (fec_length_ + 31) / 32;
+
+               switch (multiplier_.level())
+               {
+                  case cpu::gfni  : return (1 == vectors32) ? remainder_gfni <1>(buffer, output) :
+                                                              remainder_gfni <2>(buffer, output);
+
+                  case cpu::avx2  : return (1 == vectors32) ? remainder_avx2 <1>(buffer, output) :
+                                                              remainder_avx2 <2>(buffer, output);
+
+                  case cpu::ssse3 : return (1 == vectors16) ? remainder_ssse3<1>(buffer, output) :
+                                           (2 == vectors16) ? remainder_ssse3<2>(buffer, output) :
+                                                              remainder_ssse3<4>(buffer, output);
+                  default         : break;
+               }
+               #endif
+
+               return remainder_scalar(buffer, output);
+            }
+
+         private:
+
+            remainder_kernel(const remainder_kernel&);
+            remainder_kernel& operator=(const remainder_kernel&);
+
+            inline unsigned char* combine_vector(const std::size_t segment, const std::size_t j)
+            {
+               return &combine_[((segment * fec_length_) + j) * 3 * stride];
+            }
+
+            inline const unsigned char* combine_vector(const std::size_t segment, const std::size_t j) const
+            {
+               return &combine_[((segment * fec_length_) + j) * 3 * stride];
+            }
+
+            static void split(unsigned char* vector)
+            {
+               /*
+                 Each vector of stride symbols is followed by its low and
+                 its high nibbles, the operands of the byte shuffles.
+               */
+
+               for (std::size_t i = 0; i < stride; ++i)
+               {
+                  vector[stride     + i] = vector[i] & 0x0F;
+                  vector[2 * stride + i] = vector[i] >> 4;
+               }
+            }
+
+            void multiply_by_x(std::vector<unsigned char>& v) const
+            {
+               // One LFSR step upon a zero input symbol
+               const unsigned char feedback = v[0];
+
+               for (std::size_t k = 0; k < (fec_length_ - 1); ++k)
+               {
+                  v[k] = v[k + 1] ^ multiplier_.mul(feedback, feedback_[k]);
+               }
+
+               v[fec_length_ - 1] = multiplier_.mul(feedback, feedback_[fec_length_ - 1]);
+            }
+
+            bool remainder_scalar(const unsigned char input[], unsigned char output[]) const
+            {
+               unsigned char reg[segment_count][max_fec_length];
+               bool nonzero = false;
+
+               for (std::size_t s = 0; s < segment_count; ++s)
+               {
+                  std::fill_n(reg[s], fec_length_, static_cast<unsigned char>(0));
+
+                  for (std::size_t i = 0; i < segment_length_; ++i)
+                  {
+                     const unsigned char feedback = input[(s * segment_length_) + i] ^ reg[s][0];
+
+                     for (std::size_t k = 0; k < (fec_length_ - 1); ++k)
+                     {
+                        reg[s][k] = reg[s][k + 1] ^ multiplier_.mul(feedback, feedback_[k]);
+                     }
+
+                     reg[s][fec_length_ - 1] = multiplier_.mul(feedback, feedback_[fec_length_ - 1]);
+                  }
+
+                  for (std::size_t k = 0; k < fec_length_; ++k)
+                  {
+                     nonzero |= (0 != reg[s][k]);
+                  }
+               }
+
+               std::fill_n(output, fec_length_, static_cast<unsigned char>(0));
+
+               if (!nonzero)
+                  return false;
+
+               for (std::size_t s = 0; s < segment_count; ++s)
+               {
+                  for (std::size_t j = 0; j < fec_length_; ++j)
+                  {
+                     if (reg[s][j])
+                     {
+                        multiplier_.multiply_add(reg[s][j], combine_vector(s, j), output, fec_length_);
+                     }
+                  }
+               }
+
+               return true;
+            }
+
+            #if defined(SCHIFRA_X86_DISPATCH)
+
+            template <std::size_t vectors>
+            __attribute__((target("ssse3")))
+            bool remainder_ssse3(const unsigned char input[], unsigned char output[]) const
+            {
+               const unsigned char* table = multiplier_.table(0);
+
+               __m128i feedback_low [vectors];
+               __m128i feedback_high[vectors];
+               __m128i reg[segment_count][vectors];
+
+               for (std::size_t v = 0; v < vectors; ++v)
+               {
+                  feedback_low [v] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&feedback_[    stride + (16 * v)]));
+                  feedback_high[v] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&feedback_[2 * stride + (16 * v)]));
+
+                  for (std::size_t s = 0; s < segment_count; ++s)
+                  {
+                     reg[s][v] = _mm_setzero_si128();
+                  }
+               }
+
+               for (std::size_t i = 0; i < segment_length_; ++i)
+               {
+                  for (std::size_t s = 0; s < segment_count; ++s)
+                  {
+                     const unsigned char  feedback = input[(s * segment_length_) + i] ^ static_cast<unsigned char>(_mm_cvtsi128_si32(reg[s][0]));
+                     const unsigned char* t        = table + (32 * feedback);
+
+                     const __m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t     ));
+                     const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t + 16));
+
+                     for (std::size_t v = 0; v < vectors; ++v)
+                     {
+                        const __m128i shifted = ((v + 1) < vectors) ? _mm_alignr_epi8(reg[s][v + 1], reg[s][v], 1) :
+                                                                      _mm_srli_si128 (reg[s][v], 1);
+
+                        reg[s][v] = _mm_xor_si128(shifted,
+                                                  _mm_xor_si128(_mm_shuffle_epi8(low , feedback_low [v]),
+                                                                _mm_shuffle_epi8(high, feedback_high[v])));
+                     }
+                  }
+               }
+
+               __m128i nonzero = _mm_setzero_si128();
+
+               unsigned char remainder[segment_count][16 * vectors];
+
+               for (std::size_t s = 0; s < segment_count; ++s)
+               {
+                  for (std::size_t v = 0; v < vectors; ++v)
+                  {
+                     nonzero = _mm_or_si128(nonzero, reg[s][v]);
+                     _mm_storeu_si128(reinterpret_cast<__m128i*>(&remainder[s][16 * v]), reg[s][v]);
+                  }
+               }
+
+               if (0xFFFF == _mm_movemask_epi8(_mm_cmpeq_epi8(nonzero, _mm_setzero_si128())))
+               {
+                  std::fill_n(output, fec_length_, static_cast<unsigned char>(0));
+                  return false;
+               }
+
+               __m128i result[vectors];
+
+               for (std::size_t v = 0; v < vectors; ++v)
+               {
+                  result[v] = _mm_setzero_si128();
+               }
+
+               for (std::size_t s = 0; s < segment_count; ++s)
+               {
+                  for (std::size_t j = 0; j < fec_length_; ++j)
+                  {
+                     const unsigned char c = remainder[s][j];
+
+                     if (0 == c)
+                        continue;
+
+                     const unsigned char* t = table + (32 * c);
+                     const unsigned char* x = combine_vector(s, j);
+
+                     const __m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t     ));
+                     const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t + 16));
+
+                     for (std::size_t v = 0; v < vectors; ++v)
+                     {
+                        const __m128i x_low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x +     stride + (16 * v)));
+                        const __m128i x_high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + 2 * stride + (16 * v)));
+
+                        result[v] = _mm_xor_si128(result[v],
+                                                  _mm_xor_si128(_mm_shuffle_epi8(low , x_low ),
+                                                                _mm_shuffle_epi8(high, x_high)));
+                     }
+                  }
+               }
+
+               unsigned char product[16 * vectors];
+
+               for (std::size_t v = 0; v < vectors; ++v)
+               {
+                  _mm_storeu_si128(reinterpret_cast<__m128i*>(&product[16 * v]), result[v]);
+               }
+
+               std::copy(product, product + fec_length_, output);
+
+               return true;
+            }
+
+            template <std::size_t vectors>
+            __attribute__((target("avx2")))
+            static inline __m256i shift_right_one(const __m256i reg[], const std::size_t v)
+            {
+               /*
+                 Symbol k + 1 into symbol k, across the whole register of
+                 vectors * 32 symbols.
+               */
+
+               const __m256i next = ((v + 1) < vectors) ? _mm256_permute2x128_si256(reg[v], reg[v + 1], 0x21) :
+                                                          _mm256_permute2x128_si256(reg[v], reg[v    ], 0x81);
+
+               return _mm256_alignr_epi8(next, reg[v], 1);
+            }
+
+            template <std::size_t vectors>
+            __attribute__((target("avx2")))
+            bool remainder_avx2(const unsigned char input[], unsigned char output[]) const
+            {
+               const unsigned char* table = multiplier_.table(0);
+
+               __m256i feedback_low [vectors];
+               __m256i feedback_high[vectors];
+               __m256i reg[segment_count][vectors];
+
+               for (std::size_t v = 0; v < vectors; ++v)
+               {
+                  feedback_low [v] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&feedback_[    stride + (32 * v)]));
+                  feedback_high[v] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&feedback_[2 * stride + (32 * v)]));
+
+                  for (std::size_t s = 0; s < segment_count; ++s)
+                  {
+                     reg[s][v] = _mm256_setzero_si256();
+                  }
+               }
+
+               for (std::size_t i = 0; i < segment_length_; ++i)
+               {
+                  for (std::size_t s = 0; s < segment_count; ++s)
+                  {
+                     const unsigned char  feedback = input[(s * segment_length_) + i] ^ static_cast<unsigned char>(_mm_cvtsi128_si32(_mm256_castsi256_si128(reg[s][0])));
+                     const unsigned char* t        = table + (32 * feedback);
+
+                     const __m256i low  = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t     )));
+                     const __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t + 16)));
+
+                     __m256i shifted[vectors];
+
+                     for (std::size_t v = 0; v < vectors; ++v)
+                     {
+                        shifted[v] = shift_right_one<vectors>(reg[s], v);
+                     }
+
+                     for (std::size_t v = 0; v < vectors; ++v)
+                     {
+                        reg[s][v] = _mm256_xor_si256(shifted[v],
+                                                     _mm256_xor_si256(_mm256_shuffle_epi8(low , feedback_low [v]),
+                                                                      _mm256_shuffle_epi8(high, feedback_high[v])));
+                     }
+                  }
+               }
+
+               return combine_avx2<vectors>(reg, output);
+            }
+
+            template <std::size_t vectors>
+            __attribute__((target("avx2,gfni")))
+            bool remainder_gfni(const unsigned char input[], unsigned char output[]) const
+            {
+               __m256i feedback[vectors];
+               __m256i reg[segment_count][vectors];
+
+               for (std::size_t v = 0; v < vectors; ++v)
+               {
+                  feedback[v] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&feedback_[32 * v]));
+
+                  for (std::size_t s = 0; s < segment_count; ++s)
+                  {
+                     reg[s][v] = _mm256_setzero_si256();
+                  }
+               }
+
+               for (std::size_t i = 0; i < segment_length_; ++i)
+               {
+                  for (std::size_t s = 0; s < segment_count; ++s)
+                  {
+                     const unsigned char feedback_symbol = input[(s * segment_length_) + i] ^ static_cast<unsigned char>(_mm_cvtsi128_si32(_mm256_castsi256_si128(reg[s][0])));
+
+                     const __m256i matrix = _mm256_set1_epi64x(static_cast<long long>(multiplier_.matrix(feedback_symbol)));
+
+                     __m256i shifted[vectors];
+
+                     for (std::size_t v = 0; v < vectors; ++v)
+                     {
+                        shifted[v] = shift_right_one<vectors>(reg[s], v);
+                     }
+
+                     for (std::size_t v = 0; v < vectors; ++v)
+                     {
+                        reg[s][v] = _mm256_xor_si256(shifted[v], _mm256_gf2p8affine_epi64_epi8(feedback[v], matrix, 0));
+                     }
+                  }
+               }
+
+               return combine_avx2_gfni<vectors>(reg, output);
+            }
+
+            template <std::size_t vectors>
+            __attribute__((target("avx2")))
+            bool combine_avx2(const __m256i reg[segment_count][vectors], unsigned char output[]) const
+            {
+               unsigned char remainder[segment_count][32 * vectors];
+
+               __m256i nonzero = _mm256_setzero_si256();
+
+               for (std::size_t s = 0; s < segment_count; ++s)
+               {
+                  for (std::size_t v = 0; v < vectors; ++v)
+                  {
+                     nonzero = _mm256_or_si256(nonzero, reg[s][v]);
+                     _mm256_storeu_si256(reinterpret_cast<__m256i*>(&remainder[s][32 * v]), reg[s][v]);
+                  }
+               }
+
+               if (_mm256_testz_si256(nonzero, nonzero))
+               {
+                  std::fill_n(output, fec_length_, static_cast<unsigned char>(0));
+                  return false;
+               }
+
+               const unsigned char* table = multiplier_.table(0);
+
+               __m256i result[vectors];
+
+               for (std::size_t v = 0; v < vectors; ++v)
+               {
+                  result[v] = _mm256_setzero_si256();
+               }
+
+               for (std::size_t s = 0; s < segment_count; ++s)
+               {
+                  for (std::size_t j = 0; j < fec_length_; ++j)
+                  {
+                     const unsigned char c = remainder[s][j];
+
+                     if (0 == c)
+                        continue;
+
+                     const unsigned char* t = table + (32 * c);
+                     const unsigned char* x = combine_vector(s, j);
+
+                     const __m256i low  = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t     )));
+                     const __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t + 16)));
+
+                     for (std::size_t v = 0; v < vectors; ++v)
+                     {
+                        const __m256i x_low  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x +     stride + (32 * v)));
+                        const __m256i x_high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + 2 * stride + (32 * v)));
+
+                        result[v] = _mm256_xor_si256(result[v],
+                                                     _mm256_xor_si256(_mm256_shuffle_epi8(low , x_low ),
+                                                                      _mm256_shuffle_epi8(high, x_high)));
+                     }
+                  }
+               }
+
+               unsigned char product[32 * vectors];
+
+               for (std::size_t v = 0; v < vectors; ++v)
+               {
+                  _mm256_storeu_si256(reinterpret_cast<__m256i*>(&product[32 * v]), result[v]);
+               }
+
+               std::copy(product, product + fec_length_, output);
+
+               return true;
+            }
+
+            template <std::size_t vectors>
+            __attribute__((target("avx2,gfni")))
+            bool combine_avx2_gfni(const __m256i reg[segment_count][vectors], unsigned char output[]) const
+            {
+               unsigned char remainder[segment_count][32 * vectors];
+
+               __m256i nonzero = _mm256_setzero_si256();
+
+               for (std::size_t s = 0; s < segment_count; ++s)
+               {
+                  for (std::size_t v = 0; v < vectors; ++v)
+                  {
+                     nonzero = _mm256_or_si256(nonzero, reg[s][v]);
+                     _mm256_storeu_si256(reinterpret_cast<__m256i*>(&remainder[s][32 * v]), reg[s][v]);
+                  }
+               }
+
+               if (_mm256_testz_si256(nonzero, nonzero))
+               {
+                  std::fill_n(output, fec_length_, static_cast<unsigned char>(0));
+                  return false;
+               }
+
+               __m256i result[vectors];
+
+               for (std::size_t v = 0; v < vectors; ++v)
+               {
+                  result[v] = _mm256_setzero_si256();
+               }
+
+               for (std::size_t s = 0; s < segment_count; ++s)
+               {
+                  for (std::size_t j = 0; j < fec_length_; ++j)
+                  {
+                     const unsigned char c = remainder[s][j];
+
+                     if (0 == c)
+                        continue;
+
+                     const __m256i matrix = _mm256_set1_epi64x(static_cast<long long>(multiplier_.matrix(c)));
+                     const unsigned char* x = combine_vector(s, j);
+
+                     for (std::size_t v = 0; v < vectors; ++v)
+                     {
+                        result[v] = _mm256_xor_si256(result[v],
+                                                     _mm256_gf2p8affine_epi64_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + (32 * v))), matrix, 0));
+                     }
+                  }
+               }
+
+               unsigned char product[32 * vectors];
+
+               for (std::size_t v = 0; v < vectors; ++v)
+               {
+                  _mm256_storeu_si256(reinterpret_cast<__m256i*>(&product[32 * v]), result[v]);
+               }
+
+               std::copy(product, product + fec_length_, output);
+
+               return true;
+            }
+
+            #endif
+
+            const galois::region_multiplier& multiplier_;
+            const bool                       valid_;
+            const std::size_t                fec_length_;
+            const std::size_t                input_length_;
+            const std::size_t                segment_length_;
+            const std::size_t                padding_;
+            std::vector<unsigned char>       feedback_;
+            std::vector<unsigned char>       combine_;
+         };
+
+         class chien_kernel
+         {
+         public:
+
+            /*
+              Evaluates the error locator polynomial over a block of 32
+              consecutive candidates at a time: with base[j] = lambda[j] *
+              alpha^(j * i), the value at candidate i + t is the sum over j
+              of base[j] * alpha^(j * t), each term being a constant
+              (base[j]) times a fixed vector - which is what the byte
+              shuffles (or the GFNI affine transform) evaluate. The even
+              and odd sums are kept apart as per the scalar search.
+            */
+
+            enum
+            {
+               block_size = 32,
+               max_degree = 255
+            };
+
+            chien_kernel(const galois::region_multiplier& multiplier,
+                         const galois::field&             field,
+                         const std::size_t                max_lambda_degree)
+            : multiplier_(multiplier),
+              valid_(
+                      (cpu::scalar != multiplier.level()) &&
+                      (multiplier.valid())                &&
+                      (max_lambda_degree <= max_degree)
+                    ),
+              max_lambda_degree_(max_lambda_degree)
+            {
+               if (!valid_)
+                  return;
+
+               const int field_size = static_cast<int>(field.size());
+
+               vectors_.resize((max_lambda_degree_ + 1) * 3 * block_size, 0);
+               block_step_.resize(max_lambda_degree_ + 1, 0);
+
+               for (std::size_t j = 0; j <= max_lambda_degree_; ++j)
+               {
+                  unsigned char* vector = &vectors_[j * 3 * block_size];
+
+                  for (std::size_t t = 0; t < block_size; ++t)
+                  {
+                     vector[t                 ] = static_cast<unsigned char>(field.alpha(static_cast<int>((j * t) % field_size)));
+                     vector[t +     block_size] = vector[t] & 0x0F;
+                     vector[t + 2 * block_size] = vector[t] >> 4;
+                  }
+
+                  block_step_[j] = static_cast<unsigned char>(field.alpha(static_cast<int>((j * block_size) % field_size)));
+               }
+            }
+
+            inline bool valid() const
+            {
+               return valid_;
+            }
+
+            std::size_t find_roots(const unsigned char base[],
+                                   const int           lambda_degree,
+                                   const int           first_candidate,
+                                   const int           last_candidate,
+                                   int                 root_list[],
+                                   unsigned char       odd_sum_list[]) const
+            {
+               /*
+                 Candidates first_candidate through to last_candidate, the
+                 search ending once lambda_degree roots have been found.
+               */
+
+               if ((lambda_degree <= 0) || (static_cast<std::size_t>(lambda_degree) > max_lambda_degree_))
+                  return 0;
+
+               unsigned char reg[max_degree + 1];
+
+               std::copy(base, base + lambda_degree + 1, reg);
+
+               std::size_t root_count = 0;
+
+               for (int i = first_candidate; i <= last_candidate; i += block_size)
+               {
+                  unsigned char even_sum[block_size];
+                  unsigned char odd_sum [block_size];
+
+                  evaluate(reg, lambda_degree, even_sum, odd_sum);
+
+                  const int candidates = std::min<int>(block_size, last_candidate - i + 1);
+
+                  for (int t = 0; t < candidates; ++t)
+                  {
+                     if (even_sum[t] == odd_sum[t])
+                     {
+                        root_list   [root_count] = i + t;
+                        odd_sum_list[root_count] = odd_sum[t];
+
+                        if (static_cast<std::size_t>(lambda_degree) == ++root_count)
+                        {
+                           return root_count;
+                        }
+                     }
+                  }
+
+                  for (int j = 1; j <= lambda_degree; ++j)
+                  {
+                     reg[j] = multiplier_.mul(reg[j], block_step_[j]);
+                  }
+               }
+
+               return root_count;
+            }
+
+         private:
+
+            chien_kernel(const chien_kernel&);
+            chien_kernel& operator=(const chien_kernel&);
+
+            inline void evaluate(const unsigned char reg[],
+                                 const int           lambda_degree,
+                                 unsigned char       even_sum[],
+                                 unsigned char       odd_sum[]) const
+            {
+               #if defined(SCHIFRA_X86_DISPATCH)
+               switch (multiplier_.level())
+               {
+                  case cpu::gfni  : evaluate_gfni (reg, lambda_degree, even_sum, odd_sum); return;
+                  case cpu::avx2  : evaluate_avx2 (reg, lambda_degree, even_sum, odd_sum); return;
+                  case cpu::ssse3 : evaluate_ssse3(reg, lambda_degree, even_sum, odd_sum); return;
+                  default         : break;
+               }
+               #endif
+
+               std::fill_n(even_sum, block_size, reg[0]);
+               std::fill_n(odd_sum , block_size, static_cast<unsigned char>(0));
+
+               for (int j = 1; j <= lambda_degree; ++j)
+               {
+                  if (reg[j])
+                  {
+                     multiplier_.multiply_add(reg[j], &vectors_[j * 3 * block_size], ((j & 1) ? odd_sum : even_sum), block_size);
+                  }
+               }
+            }
+
+            #if defined(SCHIFRA_X86_DISPATCH)
+
+            __attribute__((target("ssse3")))
+            void evaluate_ssse3(const unsigned char reg[],
+                                const int           lambda_degree,
+                                unsigned char       even_sum[],
+                                unsigned char       odd_sum[]) const
+            {
+               const unsigned char* table = multiplier_.table(0);
+
+               __m128i even[2];
+               __m128i odd [2];
+
+               even[0] = even[1] = _mm_set1_epi8(static_cast<char>(reg[0]));
+               odd [0] = odd [1] = _mm_setzero_si128();
+
+               for (int j = 1; j <= lambda_degree; ++j)
+               {
+                  if (0 == reg[j])
+                     continue;
+
+                  const unsigned char* t = table + (32 * reg[j]);
+                  const unsigned char* x = &vectors_[j * 3 * block_size];
+
+                  const __m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t     ));
+                  const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t + 16));
+
+                  for (std::size_t v = 0; v < 2; ++v)
+                  {
+                     const __m128i x_low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x +     block_size + (16 * v)));
+                     const __m128i x_high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + 2 * block_size + (16 * v)));
+
+                     const __m128i product = _mm_xor_si128(_mm_shuffle_epi8(low , x_low ),
+                                                           _mm_shuffle_epi8(high, x_high));
+
+                     if (j & 1)
+                        odd [v] = _mm_xor_si128(odd [v], product);
+                     else
+                        even[v] = _mm_xor_si128(even[v], product);
+                  }
+               }
+
+               _mm_storeu_si128(reinterpret_cast<__m128i*>(even_sum     ), even[0]);
+               _mm_storeu_si128(reinterpret_cast<__m128i*>(even_sum + 16), even[1]);
+               _mm_storeu_si128(reinterpret_cast<__m128i*>(odd_sum      ), odd [0]);
+               _mm_storeu_si128(reinterpret_cast<__m128i*>(odd_sum  + 16), odd [1]);
+            }
+
+            __attribute__((target("avx2")))
+            void evaluate_avx2(const unsigned char reg[],
+                               const int           lambda_degree,
+                               unsigned char       even_sum[],
+                               unsigned char       odd_sum[]) const
+            {
+               const unsigned char* table = multiplier_.table(0);
+
+               __m256i even = _mm256_set1_epi8(static_cast<char>(reg[0]));
+               __m256i odd  = _mm256_setzero_si256();
+
+               for (int j = 1; j <= lambda_degree; ++j)
+               {
+                  if (0 == reg[j])
+                     continue;
+
+                  const unsigned char* t = table + (32 * reg[j]);
+                  const unsigned char* x = &vectors_[j * 3 * block_size];
+
+                  const __m256i low    = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t     )));
+                  const __m256i high   = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t + 16)));
+                  const __m256i x_low  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x +     block_size));
+                  const __m256i x_high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + 2 * block_size));
+
+                  const __m256i product = _mm256_xor_si256(_mm256_shuffle_epi8(low , x_low ),
+                                                           _mm256_shuffle_epi8(high, x_high));
+
+                  if (j & 1)
+                     odd  = _mm256_xor_si256(odd , product);
+                  else
+                     even = _mm256_xor_si256(even, product);
+               }
+
+               _mm256_storeu_si256(reinterpret_cast<__m256i*>(even_sum), even);
+               _mm256_storeu_si256(reinterpret_cast<__m256i*>(odd_sum ), odd );
+            }
+
+            __attribute__((target("avx2,gfni")))
+            void evaluate_gfni(const unsigned char reg[],
+                               const int           lambda_degree,
+                               unsigned char       even_sum[],
+                               unsigned char       odd_sum[]) const
+            {
+               __m256i even = _mm256_set1_epi8(static_cast<char>(reg[0]));
+               __m256i odd  = _mm256_setzero_si256();
+
+               for (int j = 1; j <= lambda_degree; ++j)
+               {
+                  if (0 == reg[j])
+                     continue;
+
+                  const __m256i matrix = _mm256_set1_epi64x(static_cast<long long>(multiplier_.matrix(reg[j])));
+                  const __m256i x      = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&vectors_[j * 3 * block_size]));
+
+                  const __m256i product = _mm256_gf2p8affine_epi64_epi8(x, matrix, 0);
+
+                  if (j & 1)
+                     odd  = _mm256_xor_si256(odd , product);
+                  else
+                     even = _mm256_xor_si256(even, product);
+               }
+
+               _mm256_storeu_si256(reinterpret_cast<__m256i*>(even_sum), even);
+               _mm256_storeu_si256(reinterpret_cast<__m256i*>(odd_sum ), odd );
+            }
+
+            #endif
+
+            const galois::region_multiplier& multiplier_;
+            const bool                       valid_;
+            const std::size_t                max_lambda_degree_;
+            std::vector<unsigned char>       vectors_;
+            std::vector<unsigned char>       block_step_;
+         };
+
+      } // namespace details
+
+   } // namespace reed_solomon
+
+} // namespace schifra
+
+#endif
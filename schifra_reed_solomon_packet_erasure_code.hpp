@@ -0,0 +1,259 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+#ifndef INCLUDE_SCHIFRA_REED_SOLOMON_PACKET_ERASURE_CODE_HPP
+#define INCLUDE_SCHIFRA_REED_SOLOMON_PACKET_ERASURE_CODE_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "schifra_galois_field.hpp"
+#include "schifra_galois_field_region.hpp"
+#include "schifra_reed_solomon_block.hpp"
+#include "schifra_reed_solomon_erasure_recovery.hpp"
+
+
+namespace schifra
+{
+
+   namespace reed_solomon
+   {
+
+      class packet_erasure_code
+      {
+      public:
+
+         /*
+           A systematic k + m erasure code over packets of any (equal)
+           length: k data packets give m parity packets, and any m or fewer
+           missing packets are recovered from any k of the others. Byte i
+           of the k + m packets is a codeword of the shortened Reed-Solomon
+           code RS(k + m, k) whose generator has the roots alpha^b ..
+           alpha^(b + m - 1) - ie: the parity is that of the encoder given
+           make_sequential_root_generator_polynomial(field, b, m). Hence
+           k + m may not exceed the field size, and the field is to be
+           GF(2^8) so that any byte is a symbol.
+
+           Whether encoding (the targets being the parity packets) or
+           recovering (the targets being the missing packets), each target
+           is a linear combination of k source packets. With X(p) the
+           locator alpha^(k + m - 1 - p) of packet p, S the sources and E
+           the m positions other than the sources, which include the
+           targets, the coefficients of target e are those of the erasure
+           channel decoder:
+
+              R[e][s] = (X(s) / X(e))^b * P(X(s)) / ((X(s) + X(e)) * P'(X(e)))
+
+           where P(x) = prod[j in E](x + X(j)) (see details::erasure_recovery).
+           The encoding matrix is computed at construction, the decoding
+           matrix once per loss pattern - cached in the caller's workspace -
+           and the packets are then combined with region multiply-accumulates.
+         */
+
+         struct workspace
+         {
+            /*
+              Owned by the caller and reused across calls (one per thread),
+              holding a small LRU cache of decoding matrices keyed by the
+              sorted set of missing packets, as the same packets commonly
+              stay missing (eg: a failed storage node) for many stripes,
+              and the packet pointers of the current decode.
+            */
+
+            enum { decode_cache_size = details::erasure_recovery::cache_size };
+
+            details::erasure_recovery::cache  recovery_cache;
+            std::vector<const unsigned char*> source;
+            std::vector<unsigned char*>       target;
+         };
+
+         packet_erasure_code(const galois::field& field,
+                             const std::size_t    data_count,
+                             const std::size_t    parity_count,
+                             const unsigned int   gen_initial_index = 0)
+         : data_count_(data_count),
+           parity_count_(parity_count),
+           valid_(
+                   (8 == field.pwr())                            &&
+                   (0 < data_count)                              &&
+                   (0 < parity_count)                            &&
+                   ((data_count + parity_count) <= field.size())
+                 ),
+           recovery_(field, data_count + parity_count, data_count, gen_initial_index),
+           multiplier_(field)
+         {
+            if (!valid_)
+               return;
+
+            std::vector<std::size_t> parity(parity_count_);
+
+            for (std::size_t i = 0; i < parity_count_; ++i)
+            {
+               parity[i] = data_count_ + i;
+            }
+
+            details::erasure_recovery::cache build_space;
+
+            recovery_.build(&parity[0], parity_count_, encode_matrix_, build_space);
+         }
+
+         inline bool valid() const
+         {
+            return valid_;
+         }
+
+         inline std::size_t data_count() const
+         {
+            return data_count_;
+         }
+
+         inline std::size_t parity_count() const
+         {
+            return parity_count_;
+         }
+
+         inline std::size_t packet_count() const
+         {
+            return data_count_ + parity_count_;
+         }
+
+         inline bool encode(const unsigned char* const data[], unsigned char* const parity[], const std::size_t length) const
+         {
+            // parity[0 .. m - 1] from data[0 .. k - 1], each of length bytes
+            if (!valid_)
+            {
+               return false;
+            }
+
+            combine(data, parity, parity_count_, &encode_matrix_.coefficient[0], length);
+
+            return true;
+         }
+
+         inline bool decode(unsigned char* const packet[], const erasure_locations_t& missing, const std::size_t length) const
+         {
+            workspace ws;
+            return decode(packet, missing, length, ws);
+         }
+
+         inline bool decode(unsigned char* const packet[],
+                            const erasure_locations_t& missing,
+                            const std::size_t length,
+                            workspace& ws) const
+         {
+            /*
+              packet[0 .. k + m - 1] are the data then the parity packets,
+              those listed as missing are recovered into the memory pointed
+              to, from k of the others.
+
+              Note: The missing packet indices must be unique and exist
+                    within the packet count. The order in which they are
+                    listed is of no consequence.
+            */
+
+            if (!valid_ || (missing.size() > parity_count_))
+            {
+               return false;
+            }
+            else if (missing.empty())
+            {
+               return true;
+            }
+
+            const details::erasure_recovery::matrix* matrix = recovery_.lookup(missing, ws.recovery_cache);
+
+            if (0 == matrix)
+            {
+               return false;
+            }
+
+            const std::size_t target_count = matrix->erasure_count;
+
+            ws.source.resize(data_count_);
+            ws.target.resize(target_count);
+
+            for (std::size_t i = 0; i < data_count_; ++i)
+            {
+               ws.source[i] = packet[matrix->sources[i]];
+            }
+
+            for (std::size_t i = 0; i < target_count; ++i)
+            {
+               ws.target[i] = packet[matrix->erasures[i]];
+            }
+
+            combine(&ws.source[0], &ws.target[0], target_count, &matrix->coefficient[0], length);
+
+            return true;
+         }
+
+      private:
+
+         packet_erasure_code(const packet_erasure_code&);
+         packet_erasure_code& operator=(const packet_erasure_code&);
+
+         /*
+           The packets are combined a span at a time, so that the span of
+           each of the k sources is read from cache for all of the targets.
+         */
+         enum { span_length = 4096 };
+
+         inline void combine(const unsigned char* const  source[],
+                             unsigned char* const        target[],
+                             const std::size_t           target_count,
+                             const galois::field_symbol* matrix,
+                             const std::size_t           length) const
+         {
+            for (std::size_t offset = 0; offset < length; offset += span_length)
+            {
+               const std::size_t span = std::min<std::size_t>(span_length, length - offset);
+
+               for (std::size_t t = 0; t < target_count; ++t)
+               {
+                  const galois::field_symbol* r   = matrix + (t * data_count_);
+                  unsigned char*              dst = target[t] + offset;
+
+                  multiplier_.multiply(static_cast<unsigned char>(r[0]), source[0] + offset, dst, span);
+
+                  for (std::size_t s = 1; s < data_count_; ++s)
+                  {
+                     multiplier_.multiply_add(static_cast<unsigned char>(r[s]), source[s] + offset, dst, span);
+                  }
+               }
+            }
+         }
+
+         const std::size_t                 data_count_;
+         const std::size_t                 parity_count_;
+         const bool                        valid_;
+         const details::erasure_recovery   recovery_;
+         const galois::region_multiplier   multiplier_;
+         details::erasure_recovery::matrix encode_matrix_;
+      };
+
+   } // namespace reed_solomon
+
+} // namespace schifra
+
+#endif
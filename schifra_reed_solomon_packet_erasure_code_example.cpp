@@ -0,0 +1,270 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+/*
+   Description: This example demonstrates how to protect k data packets of any
+                length by m parity packets, such that any m of the k + m
+                packets may be lost (eg: storage nodes or datagrams) and be
+                recovered from the remaining ones. Every loss pattern of up
+                to m packets is recovered and the parity is checked against
+                that of the shortened Reed-Solomon encoder.
+*/
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "schifra_galois_field.hpp"
+#include "schifra_galois_field_polynomial.hpp"
+#include "schifra_sequential_root_generator_polynomial_creator.hpp"
+#include "schifra_reed_solomon_block.hpp"
+#include "schifra_reed_solomon_encoder.hpp"
+#include "schifra_reed_solomon_packet_erasure_code.hpp"
+#include "schifra_utilities.hpp"
+
+
+int main()
+{
+   /* Packet Erasure Code Parameters */
+   const std::size_t data_count    = 10;
+   const std::size_t parity_count  =  4;
+   const std::size_t packet_count  = data_count + parity_count;
+   const std::size_t packet_length = 16 * 1024 + 3;
+
+   /* Finite Field Parameters */
+   const std::size_t field_descriptor           =   8;
+   const std::size_t generator_polynomial_index = 120;
+
+   /* Instantiate Finite Field and Generator Polynomials */
+   const schifra::galois::field field(field_descriptor,
+                                      schifra::galois::primitive_polynomial_size06,
+                                      schifra::galois::primitive_polynomial06);
+
+   schifra::galois::field_polynomial generator_polynomial(field);
+
+   if (
+        !schifra::make_sequential_root_generator_polynomial(field,
+                                                            generator_polynomial_index,
+                                                            parity_count,
+                                                            generator_polynomial)
+      )
+   {
+      std::cout << "Error - Failed to create sequential root generator!" << std::endl;
+      return 1;
+   }
+
+   const schifra::reed_solomon::packet_erasure_code code(field,
+                                                        data_count,
+                                                        parity_count,
+                                                        generator_polynomial_index);
+
+   if (!code.valid())
+   {
+      std::cout << "Error - Invalid packet erasure code parameters!" << std::endl;
+      return 1;
+   }
+
+   std::vector<std::vector<unsigned char> > sent(packet_count, std::vector<unsigned char>(packet_length));
+   std::vector<std::vector<unsigned char> > recv(packet_count, std::vector<unsigned char>(packet_length));
+
+   std::vector<const unsigned char*> data  (data_count  );
+   std::vector<unsigned char*>       parity(parity_count);
+   std::vector<unsigned char*>       packet(packet_count);
+
+   for (std::size_t i = 0; i < packet_count; ++i)
+   {
+      if (i < data_count)
+      {
+         for (std::size_t j = 0; j < packet_length; ++j)
+         {
+            sent[i][j] = static_cast<unsigned char>((i * 7 + j * 13 + (j >> 8)) & 0xFF);
+         }
+
+         data[i] = &sent[i][0];
+      }
+      else
+         parity[i - data_count] = &sent[i][0];
+
+      packet[i] = &recv[i][0];
+   }
+
+   if (!code.encode(&data[0], &parity[0], packet_length))
+   {
+      std::cout << "Error - Failed to encode packets!" << std::endl;
+      return 1;
+   }
+
+   /* Byte j of each packet forms a codeword of the shortened code RS(k + m, k) */
+   {
+      typedef schifra::reed_solomon::shortened_encoder<packet_count,parity_count> encoder_t;
+
+      const encoder_t rs_encoder(field,generator_polynomial);
+
+      for (std::size_t j = 0; j < packet_length; j += 97)
+      {
+         encoder_t::block_type block;
+
+         for (std::size_t i = 0; i < data_count; ++i)
+         {
+            block[i] = sent[i][j];
+         }
+
+         if (!rs_encoder.encode(block))
+         {
+            std::cout << "Error - Failed to encode block!" << std::endl;
+            return 1;
+         }
+
+         for (std::size_t i = 0; i < parity_count; ++i)
+         {
+            if (block.fec(i) != sent[data_count + i][j])
+            {
+               std::cout << "Error - Parity differs from the shortened encoder! packet: " << data_count + i << std::endl;
+               return 1;
+            }
+         }
+      }
+   }
+
+   /* Lose every pattern of up to parity_count packets, and recover them */
+   schifra::reed_solomon::packet_erasure_code::workspace workspace;
+
+   std::size_t pattern_count = 0;
+
+   for (std::size_t pattern = 1; pattern < (std::size_t(1) << packet_count); ++pattern)
+   {
+      schifra::reed_solomon::erasure_locations_t missing;
+
+      for (std::size_t i = 0; i < packet_count; ++i)
+      {
+         if (pattern & (std::size_t(1) << i))
+         {
+            missing.push_back(i);
+         }
+      }
+
+      if (missing.size() > parity_count)
+         continue;
+
+      for (std::size_t i = 0; i < packet_count; ++i)
+      {
+         if (pattern & (std::size_t(1) << i))
+            std::fill(recv[i].begin(), recv[i].end(), static_cast<unsigned char>(0));
+         else
+            recv[i] = sent[i];
+      }
+
+      if (!code.decode(&packet[0], missing, packet_length, workspace))
+      {
+         std::cout << "Error - Failed to recover packets! pattern: " << pattern << std::endl;
+         return 1;
+      }
+
+      if (recv != sent)
+      {
+         std::cout << "Error - Recovered packets differ from those sent! pattern: " << pattern << std::endl;
+         return 1;
+      }
+
+      ++pattern_count;
+   }
+
+   std::cout << "Recovered all " << pattern_count << " loss patterns of up to "
+             << parity_count << " of " << packet_count << " packets" << std::endl;
+
+   /* Throughput over large packets, the lost packets being the first parity_count data packets */
+   {
+      const std::size_t large_length = 1024 * 1024 + 1;
+      const std::size_t rounds       = 32;
+
+      std::vector<std::vector<unsigned char> > large(packet_count, std::vector<unsigned char>(large_length));
+
+      for (std::size_t i = 0; i < packet_count; ++i)
+      {
+         for (std::size_t j = 0; j < large_length; ++j)
+         {
+            large[i][j] = static_cast<unsigned char>((i * 11 + j * 3) & 0xFF);
+         }
+
+         packet[i] = &large[i][0];
+
+         if (i < data_count)
+            data[i] = &large[i][0];
+         else
+            parity[i - data_count] = &large[i][0];
+      }
+
+      schifra::reed_solomon::erasure_locations_t missing;
+
+      for (std::size_t i = 0; i < parity_count; ++i)
+      {
+         missing.push_back(i);
+      }
+
+      schifra::utils::timer timer;
+
+      timer.start();
+
+      for (std::size_t r = 0; r < rounds; ++r)
+      {
+         code.encode(&data[0], &parity[0], large_length);
+      }
+
+      timer.stop();
+
+      const double encode_time = timer.time();
+
+      const std::vector<std::vector<unsigned char> > encoded = large;
+
+      timer.start();
+
+      for (std::size_t r = 0; r < rounds; ++r)
+      {
+         code.decode(&packet[0], missing, large_length, workspace);
+      }
+
+      timer.stop();
+
+      const double decode_time = timer.time();
+
+      if (large != encoded)
+      {
+         std::cout << "Error - Recovered large packets differ from those encoded!" << std::endl;
+         return 1;
+      }
+
+      const double mega_bytes = (1.0 * rounds * data_count * large_length) / (1024.0 * 1024.0);
+
+      printf("RS(%lu,%lu) Packet Length: %lu\tEncode: %8.3fMB/s\tDecode (%lu lost): %8.3fMB/s\n",
+             static_cast<unsigned long>(packet_count),
+             static_cast<unsigned long>(data_count),
+             static_cast<unsigned long>(large_length),
+             mega_bytes / encode_time,
+             static_cast<unsigned long>(parity_count),
+             mega_bytes / decode_time);
+   }
+
+   return 0;
+}
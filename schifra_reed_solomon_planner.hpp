@@ -0,0 +1,421 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+#ifndef INCLUDE_SCHIFRA_REED_SOLOMON_PLANNER_HPP
+#define INCLUDE_SCHIFRA_REED_SOLOMON_PLANNER_HPP
+
+
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "schifra_cpu_features.hpp"
+#include "schifra_galois_field.hpp"
+#include "schifra_reed_solomon_decoder.hpp"
+#include "schifra_reed_solomon_runtime_codec.hpp"
+#include "schifra_utilities.hpp"
+
+
+namespace schifra
+{
+
+   namespace reed_solomon
+   {
+
+      namespace key_equation_solver
+      {
+         inline bool from_string(const std::string& solver_name, type& solver)
+         {
+            const type solver_list[] = { berlekamp_massey, inversionless_berlekamp_massey, euclidean };
+
+            for (std::size_t i = 0; i < (sizeof(solver_list) / sizeof(type)); ++i)
+            {
+               if (to_string(solver_list[i]) == solver_name)
+               {
+                  solver = solver_list[i];
+                  return true;
+               }
+            }
+
+            return false;
+         }
+      }
+
+      class planner
+      {
+      public:
+
+         /*
+           Which decoder variant is the fastest depends upon the machine and
+           upon the code: eg: the inversionless BMA trades the divisions of
+           the BMA for twice the multiplications, and the Euclidean solver's
+           cost grows differently with the erasure load. The planner measures
+           each variant, for a given field and code, upon first use - in the
+           manner of the speed evaluator's key equation solver test, but
+           over runtime codecs - and retains the fastest. The decisions (the
+           "wisdom") can be saved to and loaded from a text file, so that
+           later processes start with the tuned plan without measuring.
+           Plans are keyed by the field's power, as the table driven field
+           arithmetic performs alike for all fields of a given power, and
+           by the cpu dispatch level the plan was measured at, as the kernels
+           of one level may well favour a different variant than those of
+           another. Plans of levels other than the active level are retained
+           (and saved) but never used.
+           Note: The key equation solver is at present the only decoder
+                 stage with more than one variant.
+         */
+
+         struct plan
+         {
+            plan()
+            : level(cpu::scalar),
+              field_power(0),
+              code_length(0),
+              fec_length(0),
+              gen_initial_index(0),
+              solver(key_equation_solver::berlekamp_massey)
+            {}
+
+            cpu::level                level;
+            std::size_t               field_power;
+            std::size_t               code_length;
+            std::size_t               fec_length;
+            unsigned int              gen_initial_index;
+            key_equation_solver::type solver;
+         };
+
+         explicit planner(const double measurement_time = 0.01)
+         : measurement_time_(measurement_time)
+         {}
+
+         key_equation_solver::type solver(const galois::field& field,
+                                          const std::size_t    code_length,
+                                          const std::size_t    fec_length,
+                                          const unsigned int   gen_initial_index)
+         {
+            plan result;
+
+            if (!find(field.pwr(), code_length, fec_length, gen_initial_index, result))
+            {
+               result = create_plan(field, code_length, fec_length, gen_initial_index);
+            }
+
+            return result.solver;
+         }
+
+         bool find(const std::size_t  field_power,
+                   const std::size_t  code_length,
+                   const std::size_t  fec_length,
+                   const unsigned int gen_initial_index,
+                   plan&              result) const
+         {
+            const plan_map_t::const_iterator itr = plan_map_.find(make_key(cpu::active_level(), field_power, code_length, fec_length, gen_initial_index));
+
+            if (plan_map_.end() == itr)
+               return false;
+
+            result = itr->second;
+
+            return true;
+         }
+
+         const plan& create_plan(const galois::field& field,
+                                 const std::size_t    code_length,
+                                 const std::size_t    fec_length,
+                                 const unsigned int   gen_initial_index)
+         {
+            /*
+              Measure every variant, a few times over in alternation so as to
+              lessen the effect of a noisy machine, retaining each variant's
+              best time. Variants that fail to correct the workload (or that
+              cannot be constructed) are not considered.
+            */
+
+            const key_equation_solver::type solver_list[] =
+                                               {
+                                                 key_equation_solver::berlekamp_massey,
+                                                 key_equation_solver::inversionless_berlekamp_massey,
+                                                 key_equation_solver::euclidean
+                                               };
+
+            const std::size_t solver_list_size = sizeof(solver_list) / sizeof(key_equation_solver::type);
+            const std::size_t repetitions      = 3;
+
+            std::vector<double> best_time(solver_list_size, -1.0);
+
+            for (std::size_t r = 0; r < repetitions; ++r)
+            {
+               for (std::size_t s = 0; s < solver_list_size; ++s)
+               {
+                  const double time = measure(field, code_length, fec_length, gen_initial_index, solver_list[s]);
+
+                  if ((time > 0.0) && ((best_time[s] < 0.0) || (time < best_time[s])))
+                  {
+                     best_time[s] = time;
+                  }
+               }
+            }
+
+            plan& result = plan_map_[make_key(cpu::active_level(), field.pwr(), code_length, fec_length, gen_initial_index)];
+
+            result.level             = cpu::active_level();
+            result.field_power       = field.pwr();
+            result.code_length       = code_length;
+            result.fec_length        = fec_length;
+            result.gen_initial_index = gen_initial_index;
+            result.solver            = key_equation_solver::berlekamp_massey;
+
+            double fastest = -1.0;
+
+            for (std::size_t s = 0; s < solver_list_size; ++s)
+            {
+               if ((best_time[s] > 0.0) && ((fastest < 0.0) || (best_time[s] < fastest)))
+               {
+                  result.solver = solver_list[s];
+                  fastest       = best_time[s];
+               }
+            }
+
+            return result;
+         }
+
+         bool save(const std::string& file_name) const
+         {
+            std::ofstream stream(file_name.c_str());
+
+            if (!stream)
+               return false;
+
+            stream << "# Schifra Reed-Solomon planner wisdom" << std::endl;
+            stream << "# cpu_level field_power code_length fec_length gen_initial_index solver" << std::endl;
+
+            for (plan_map_t::const_iterator itr = plan_map_.begin(); itr != plan_map_.end(); ++itr)
+            {
+               const plan& p = itr->second;
+
+               stream << cpu::to_string(p.level) << " "
+                      << p.field_power       << " "
+                      << p.code_length       << " "
+                      << p.fec_length        << " "
+                      << p.gen_initial_index << " "
+                      << key_equation_solver::to_string(p.solver) << std::endl;
+            }
+
+            return static_cast<bool>(stream);
+         }
+
+         bool load(const std::string& file_name)
+         {
+            /*
+              Plans loaded take the place of existing plans of the same key.
+              Returns false when the file cannot be read or a line of it is
+              malformed, in which case the preceding lines remain loaded.
+              Each line begins with the cpu level its plan was measured at,
+              hence wisdom saved without a level is deemed malformed.
+            */
+
+            std::ifstream stream(file_name.c_str());
+
+            if (!stream)
+               return false;
+
+            std::string line;
+
+            while (std::getline(stream, line))
+            {
+               if (line.empty() || ('#' == line[0]))
+                  continue;
+
+               std::istringstream line_stream(line);
+
+               plan p;
+               std::string level_name;
+               std::string solver_name;
+
+               line_stream >> level_name
+                           >> p.field_power
+                           >> p.code_length
+                           >> p.fec_length
+                           >> p.gen_initial_index
+                           >> solver_name;
+
+               if (
+                    line_stream.fail()                      ||
+                    !cpu::from_string(level_name, p.level)  ||
+                    !key_equation_solver::from_string(solver_name, p.solver)
+                  )
+               {
+                  return false;
+               }
+
+               plan_map_[make_key(p.level, p.field_power, p.code_length, p.fec_length, p.gen_initial_index)] = p;
+            }
+
+            return true;
+         }
+
+         inline std::size_t size() const
+         {
+            return plan_map_.size();
+         }
+
+         inline void clear()
+         {
+            plan_map_.clear();
+         }
+
+      private:
+
+         typedef std::pair<std::pair<std::size_t,std::size_t>,std::pair<std::size_t,unsigned int> > code_key_t;
+         typedef std::pair<cpu::level,code_key_t> key_t;
+         typedef std::map<key_t,plan> plan_map_t;
+
+         static key_t make_key(const cpu::level   level,
+                               const std::size_t  field_power,
+                               const std::size_t  code_length,
+                               const std::size_t  fec_length,
+                               const unsigned int gen_initial_index)
+         {
+            return key_t(level, code_key_t(std::make_pair(field_power, code_length), std::make_pair(fec_length, gen_initial_index)));
+         }
+
+         double measure(const galois::field&            field,
+                        const std::size_t               code_length,
+                        const std::size_t               fec_length,
+                        const unsigned int              gen_initial_index,
+                        const key_equation_solver::type solver) const
+         {
+            /*
+              Seconds per block for the one variant, summed over workloads of
+              increasing erasure load (none, a quarter and a half of the fec
+              length), each with its remaining capacity consumed by errors.
+              Returns a negative value should the variant fail.
+            */
+
+            const runtime_codec codec(field, code_length, fec_length, gen_initial_index, solver);
+
+            if (!codec.valid())
+               return -1.0;
+
+            const std::size_t sample_count = 64;
+
+            runtime_codec::workspace workspace(fec_length);
+            runtime_codec::status    status;
+
+            std::vector<galois::field_symbol> original(code_length * sample_count, 0);
+            std::vector<galois::field_symbol> received(code_length * sample_count, 0);
+            std::vector<erasure_locations_t>  erasure_list(sample_count);
+
+            unsigned int seed = 0x5A5A5A5A;
+
+            for (std::size_t i = 0; i < sample_count; ++i)
+            {
+               galois::field_symbol* codeword = &original[i * code_length];
+
+               for (std::size_t j = 0; j < codec.data_length(); ++j)
+               {
+                  seed        = (seed * 1103515245) + 12345;
+                  codeword[j] = static_cast<galois::field_symbol>((seed >> 16) % (field.size() + 1));
+               }
+
+               codec.encode(codeword);
+            }
+
+            double total_time = 0.0;
+
+            for (std::size_t load = 0; load <= 2; ++load)
+            {
+               const std::size_t erasure_count = (load * fec_length) / 4;
+               const std::size_t error_count   = (fec_length - erasure_count) >> 1;
+
+               for (std::size_t i = 0; i < sample_count; ++i)
+               {
+                  const std::size_t start_position = (i * 37) % code_length;
+
+                  erasure_list[i].clear();
+
+                  for (std::size_t j = 0; j < erasure_count; ++j)
+                  {
+                     erasure_list[i].push_back((start_position + j) % code_length);
+                  }
+               }
+
+               std::size_t rounds = 0;
+
+               schifra::utils::timer timer;
+               timer.start();
+
+               do
+               {
+                  received = original;
+
+                  for (std::size_t i = 0; i < sample_count; ++i)
+                  {
+                     galois::field_symbol* codeword = &received[i * code_length];
+
+                     const std::size_t start_position = (i * 37) % code_length;
+
+                     for (std::size_t j = 0; j < erasure_count; ++j)
+                     {
+                        codeword[erasure_list[i][j]] = 0;
+                     }
+
+                     for (std::size_t j = 0; j < error_count; ++j)
+                     {
+                        galois::field_symbol& symbol = codeword[(start_position + erasure_count + (2 * j)) % code_length];
+
+                        symbol = (symbol ^ static_cast<galois::field_symbol>(1 + ((i + j) % field.size())));
+                     }
+
+                     if (!codec.decode(codeword, erasure_list[i], status, workspace))
+                     {
+                        return -1.0;
+                     }
+                  }
+
+                  ++rounds;
+                  timer.stop();
+               }
+               while (timer.time() < measurement_time_);
+
+               if (received != original)
+                  return -1.0;
+
+               total_time += timer.time() / (rounds * sample_count);
+            }
+
+            return total_time;
+         }
+
+         double     measurement_time_;
+         plan_map_t plan_map_;
+      };
+
+   } // namespace reed_solomon
+
+} // namespace schifra
+
+#endif
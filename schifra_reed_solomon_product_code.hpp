@@ -61,6 +61,11 @@ namespace schifra
 
          bool encode(data_ptr_type data)
          {
+            /*
+              The rows are encoded, then the columns - in place, by way of
+              strided views - the fec rows thus holding the column fecs.
+            */
+
             data_ptr_type curr_data_ptr = data;
 
             for (std::size_t row = 0; row < data_length; ++row, curr_data_ptr += data_length)
@@ -73,24 +78,14 @@ namespace schifra
                }
             }
 
-            block_type vertical_block;
-
             for (std::size_t col = 0; col < code_length; ++col)
             {
-               for (std::size_t row = 0; row < data_length; ++row)
-               {
-                  vertical_block[row] = block_stack_[row][col];
-               }
+               block_column_view<code_length,fec_length> column = column_view(block_stack_,col);
 
-               if (!encoder_.encode(vertical_block))
+               if (!encoder_.encode(column))
                {
                   return false;
                }
-
-               for (std::size_t fec_index = 0; fec_index < fec_length; ++fec_index)
-               {
-                  block_stack_[data_length + fec_index].fec(fec_index) = vertical_block.fec(fec_index);
-               }
             }
 
             return true;
@@ -98,12 +93,36 @@ namespace schifra
 
          bool encode_and_interleave(data_ptr_type data)
          {
-            if (!encode(data))
+            /*
+              The interleaved (transposed) product is produced directly: the
+              data rows are loaded into the columns, which are encoded, then
+              the rows, rather than transposing the encoded stack.
+            */
+
+            data_ptr_type curr_data_ptr = data;
+
+            for (std::size_t col = 0; col < data_length; ++col, curr_data_ptr += data_length)
             {
-               return false;
+               block_column_view<code_length,fec_length> column = column_view(block_stack_,col);
+
+               for (std::size_t row = 0; row < data_length; ++row)
+               {
+                  column[row] = static_cast<typename block_type::symbol_type>(curr_data_ptr[row]);
+               }
+
+               if (!encoder_.encode(column))
+               {
+                  return false;
+               }
             }
 
-            interleave<code_length,fec_length>(block_stack_);
+            for (std::size_t row = 0; row < code_length; ++row)
+            {
+               if (!encoder_.encode(block_stack_[row]))
+               {
+                  return false;
+               }
+            }
 
             return true;
          }
@@ -148,24 +167,46 @@ namespace schifra
          enum { total_size = code_length * code_length };
 
          square_product_code_decoder(const decoder_type& decoder)
-         : decoder_(decoder)
+         : decoder_(decoder),
+           transposed_(false)
          {}
 
          void decode(data_ptr_type data)
          {
             copy_proxy(data);
-            decode_proxy();
+            decode_proxy(false);
          }
 
          void deinterleave_and_decode(data_ptr_type data)
          {
+            /*
+              The rows of the product are the columns of the interleaved
+              stack, and are decoded in place as such, without a transpose.
+            */
+
             copy_proxy(data);
-            interleave<code_length,fec_length>(block_stack_);
-            decode_proxy();
+            decode_proxy(true);
          }
 
          void output(data_ptr_type output_data)
          {
+            if (transposed_)
+            {
+               for (std::size_t row = 0; row < data_length; ++row)
+               {
+                  const block_column_view<code_length,fec_length> column = column_view(block_stack_,row);
+
+                  for (std::size_t i = 0; i < data_length; ++i)
+                  {
+                     output_data[i] = static_cast<data_type>(column[i]);
+                  }
+
+                  output_data += data_length;
+               }
+
+               return;
+            }
+
             for (std::size_t row = 0; row < data_length; ++row, output_data += data_length)
             {
                bitio::convert_symbol_to_data<traits::symbol<code_length>::size>(block_stack_[row].data,output_data,data_length);
@@ -178,6 +219,8 @@ namespace schifra
             {
                block_stack_[i].clear();
             }
+
+            transposed_ = false;
          }
 
       private:
@@ -193,19 +236,17 @@ namespace schifra
             }
          }
 
-         void decode_proxy()
+         void decode_proxy(const bool transposed)
          {
-            bool first_iteration_failure = false;
+            /*
+              The data rows of the product (the stack's columns when it is
+              transposed) are decoded, and should any fail, the product's
+              columns followed by its data rows once more.
+            */
 
-            for (std::size_t row = 0; row < data_length; ++row)
-            {
-               if (!decoder_.decode(block_stack_[row]))
-               {
-                  first_iteration_failure = true;
-               }
-            }
+            transposed_ = transposed;
 
-            if (!first_iteration_failure)
+            if (decode_lines(transposed, data_length))
             {
                /*
                  Either no errors detected or all errors have
@@ -214,21 +255,38 @@ namespace schifra
                return;
             }
 
-            block_type vertical_block;
+            decode_lines(!transposed, code_length);
+            decode_lines( transposed, data_length);
+         }
 
-            for (std::size_t col = 0; col < code_length; ++col)
+         bool decode_lines(const bool columns, const std::size_t count)
+         {
+            if (!columns)
             {
-               for (std::size_t row = 0; row < data_length; ++row)
+               batch_result result;
+
+               return decoder_.decode_batch(block_stack_,count,0,result,workspace_);
+            }
+
+            bool result = true;
+
+            for (std::size_t col = 0; col < count; ++col)
+            {
+               block_column_view<code_length,fec_length> column = column_view(block_stack_,col);
+
+               if (!decoder_.decode(column,workspace_))
                {
-                  vertical_block[row] = block_stack_[row][col];
+                  result = false;
                }
-
-               decoder_.decode(vertical_block);
             }
+
+            return result;
          }
 
          block_type block_stack_[code_length];
          const decoder_type& decoder_;
+         typename decoder_type::workspace workspace_;
+         bool transposed_;
       };
 
    } // namespace reed_solomon
@@ -0,0 +1,284 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+#ifndef INCLUDE_SCHIFRA_REED_SOLOMON_RATE_CONTROLLER_HPP
+#define INCLUDE_SCHIFRA_REED_SOLOMON_RATE_CONTROLLER_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+
+namespace schifra
+{
+
+   namespace reed_solomon
+   {
+
+      class rate_controller
+      {
+      public:
+
+         /*
+           Closes the loop between the decoder's per block statistics and
+           the choice of fec length. Each decoded block contributes its
+           parity demand (2 * errors + erasures, the symbols of redundancy
+           the block actually consumed) to a sliding window. For every
+           candidate fec length f the window yields the fraction of blocks
+           whose demand exceeds f less a headroom, hence an expected goodput
+           of:
+
+              goodput(f) = ((code_length - f) / code_length) * (1 - failure_rate(f))
+
+           The controller switches to the candidate of highest goodput, but
+           only when it betters the current one by the hysteresis factor and
+           only once hold_off blocks have been decoded since the last switch,
+           so as to not oscillate between neighbouring fec lengths.
+           A failed block's demand is only known to exceed the current fec
+           length, hence it is taken to be just beyond it: the controller
+           steps up, and keeps stepping up whilst failures persist. On a
+           clean link every demand is zero and the smallest candidate wins.
+           The headroom (in parity symbols) accounts for the blocks beyond
+           a code's capability that are miscorrected rather than reported
+           as failures, which is common with the smaller fec lengths.
+         */
+
+         rate_controller(const std::size_t               code_length,
+                         const std::vector<std::size_t>& fec_length_list,
+                         const std::size_t               window_size = 1024,
+                         const std::size_t               headroom    = 2,
+                         const double                    hysteresis  = 0.01,
+                         const std::size_t               hold_off    = 0)
+         : code_length_(code_length),
+           fec_length_list_(fec_length_list),
+           window_size_(std::max<std::size_t>(window_size, 1)),
+           headroom_(headroom),
+           hysteresis_(hysteresis),
+           hold_off_((0 == hold_off) ? window_size_ : hold_off),
+           window_index_(0),
+           window_count_(0),
+           blocks_since_switch_(0),
+           switch_count_(0)
+         {
+            std::sort(fec_length_list_.begin(), fec_length_list_.end());
+
+            fec_length_list_.erase(std::unique(fec_length_list_.begin(), fec_length_list_.end()), fec_length_list_.end());
+
+            while (!fec_length_list_.empty() && (fec_length_list_.back() >= code_length_))
+            {
+               fec_length_list_.pop_back();
+            }
+
+            // Until the channel has been observed, start with the strongest code
+            current_ = (fec_length_list_.empty() ? 0 : fec_length_list_.size() - 1);
+
+            const std::size_t max_demand = (fec_length_list_.empty() ? 0 : fec_length_list_.back()) + 1;
+
+            window_.resize(window_size_, 0);
+            demand_histogram_.resize(max_demand + 1, 0);
+         }
+
+         inline bool valid() const
+         {
+            return !fec_length_list_.empty();
+         }
+
+         inline std::size_t fec_length() const
+         {
+            return (valid() ? fec_length_list_[current_] : 0);
+         }
+
+         inline std::size_t recommended_fec_length() const
+         {
+            return (valid() ? fec_length_list_[best_candidate()] : 0);
+         }
+
+         inline std::size_t switch_count() const
+         {
+            return switch_count_;
+         }
+
+         inline std::size_t observed_blocks() const
+         {
+            return window_count_;
+         }
+
+         bool update(const std::size_t errors_detected,
+                     const std::size_t erasure_count,
+                     const bool        decoded)
+         {
+            /*
+              Record one decoded block, where errors_detected is the block's
+              errata count (errors plus erasures) as reported by the decoder.
+              Returns true when the controller has switched fec length, the
+              caller then being expected to (re)configure its codec with
+              fec_length().
+            */
+
+            if (!valid())
+               return false;
+
+            std::size_t demand = 0;
+
+            if (!decoded)
+               demand = fec_length() + 1;
+            else if (errors_detected > erasure_count)
+               demand = (2 * errors_detected) - erasure_count;
+            else
+               demand = erasure_count;
+
+            record(demand);
+
+            if (++blocks_since_switch_ < hold_off_)
+               return false;
+
+            const std::size_t best = best_candidate();
+
+            if (
+                 (best != current_) &&
+                 (goodput(fec_length_list_[best]) > (goodput(fec_length()) * (1.0 + hysteresis_)))
+               )
+            {
+               current_             = best;
+               blocks_since_switch_ = 0;
+               ++switch_count_;
+
+               return true;
+            }
+
+            return false;
+         }
+
+         template <typename Block>
+         inline bool update(const Block& rsblock, const std::size_t erasure_count = 0)
+         {
+            return update(rsblock.errors_detected, erasure_count, !rsblock.unrecoverable);
+         }
+
+         double failure_rate(const std::size_t fec_length) const
+         {
+            /*
+              Fraction of the observed blocks whose demand exceeds fec_length
+              less the headroom.
+            */
+
+            if (0 == window_count_)
+               return 0.0;
+
+            const std::size_t threshold = ((fec_length > headroom_) ? (fec_length - headroom_) : 0);
+
+            std::size_t failures = 0;
+
+            for (std::size_t demand = threshold + 1; demand < demand_histogram_.size(); ++demand)
+            {
+               failures += demand_histogram_[demand];
+            }
+
+            return static_cast<double>(failures) / static_cast<double>(window_count_);
+         }
+
+         double goodput(const std::size_t fec_length) const
+         {
+            if (fec_length >= code_length_)
+               return 0.0;
+
+            const double code_rate = static_cast<double>(code_length_ - fec_length) / static_cast<double>(code_length_);
+
+            return code_rate * (1.0 - failure_rate(fec_length));
+         }
+
+         void reset()
+         {
+            std::fill(window_.begin(), window_.end(), 0);
+            std::fill(demand_histogram_.begin(), demand_histogram_.end(), 0);
+
+            window_index_        = 0;
+            window_count_        = 0;
+            blocks_since_switch_ = 0;
+         }
+
+      private:
+
+         void record(const std::size_t demand)
+         {
+            const std::size_t capped_demand = std::min(demand, demand_histogram_.size() - 1);
+
+            if (window_count_ == window_size_)
+            {
+               --demand_histogram_[window_[window_index_]];
+            }
+            else
+               ++window_count_;
+
+            window_[window_index_] = capped_demand;
+            ++demand_histogram_[capped_demand];
+
+            if (++window_index_ == window_size_)
+            {
+               window_index_ = 0;
+            }
+         }
+
+         std::size_t best_candidate() const
+         {
+            /*
+              On equal goodput the smaller fec length is preferred.
+            */
+
+            std::size_t best = 0;
+            double best_goodput = goodput(fec_length_list_[0]);
+
+            for (std::size_t i = 1; i < fec_length_list_.size(); ++i)
+            {
+               const double candidate_goodput = goodput(fec_length_list_[i]);
+
+               if (candidate_goodput > best_goodput)
+               {
+                  best         = i;
+                  best_goodput = candidate_goodput;
+               }
+            }
+
+            return best;
+         }
+
+         const std::size_t        code_length_;
+         std::vector<std::size_t> fec_length_list_;
+         const std::size_t        window_size_;
+         const std::size_t        headroom_;
+         const double             hysteresis_;
+         const std::size_t        hold_off_;
+         std::vector<std::size_t> window_;
+         std::vector<std::size_t> demand_histogram_;
+         std::size_t              window_index_;
+         std::size_t              window_count_;
+         std::size_t              blocks_since_switch_;
+         std::size_t              current_;
+         std::size_t              switch_count_;
+      };
+
+   } // namespace reed_solomon
+
+} // namespace schifra
+
+#endif
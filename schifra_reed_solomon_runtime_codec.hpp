@@ -0,0 +1,313 @@
+/*
+(**************************************************************************)
+(*                                                                        *)
+(*                                Schifra                                 *)
+(*                Reed-Solomon Error Correcting Code Library              *)
+(*                                                                        *)
+(* Release Version 0.0.1                                                  *)
+(* http://www.schifra.com                                                 *)
+(* Copyright (c) 2000-2020 Arash Partow, All Rights Reserved.             *)
+(*                                                                        *)
+(* The Schifra Reed-Solomon error correcting code library and all its     *)
+(* components are supplied under the terms of the General Schifra License *)
+(* agreement. The contents of the Schifra Reed-Solomon error correcting   *)
+(* code library and all its components may not be copied or disclosed     *)
+(* except in accordance with the terms of that agreement.                 *)
+(*                                                                        *)
+(* URL: http://www.schifra.com/license.html                               *)
+(*                                                                        *)
+(**************************************************************************)
+*/
+
+
+#ifndef INCLUDE_SCHIFRA_REED_SOLOMON_RUNTIME_CODEC_HPP
+#define INCLUDE_SCHIFRA_REED_SOLOMON_RUNTIME_CODEC_HPP
+
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "schifra_galois_field.hpp"
+#include "schifra_galois_field_polynomial.hpp"
+#include "schifra_sequential_root_generator_polynomial_creator.hpp"
+#include "schifra_reed_solomon_block.hpp"
+#include "schifra_reed_solomon_encoder.hpp"
+#include "schifra_reed_solomon_decoder.hpp"
+
+
+namespace schifra
+{
+
+   namespace reed_solomon
+   {
+
+      class runtime_codec
+      {
+      public:
+
+         /*
+           A Reed-Solomon encoder/decoder pair whose code length, fec
+           length, field and generator initial index are all given at
+           construction. Codewords are plain symbol arrays of length
+           code_length, the data symbols followed by the fec symbols.
+           Codes shorter than the field are supported directly (the
+           padding symbols being implicitly zero). The encoding and
+           decoding is performed by the very same cores used by the
+           fixed length encoder and decoder, hence the results are
+           identical to those of encoder<n,f> and decoder<n,f>.
+         */
+
+         // The decoding state of a codeword is that of a block
+         typedef block_state status;
+
+         struct erasure_pattern
+         {
+            explicit erasure_pattern(const std::size_t fec_length = 0)
+            : erasure_count(0),
+              erasures   (fec_length    ),
+              gamma      (fec_length + 1),
+              locations  (fec_length    ),
+              coefficient(fec_length    ),
+              valid(false),
+              last_used(0)
+            {}
+
+            std::size_t                       erasure_count;
+            std::vector<std::size_t>          erasures;
+            std::vector<galois::field_symbol> gamma;
+            std::vector<int>                  locations;
+            std::vector<galois::field_symbol> coefficient;
+            bool                              valid;
+            std::size_t                       last_used;
+         };
+
+         enum { erasure_cache_size = details::decoder_core::erasure_cache_size };
+
+         struct workspace
+         {
+            /*
+              The runtime sized counterpart of decoder<>::workspace, all
+              storage being allocated once upon construction. It is only
+              usable by codecs of the fec length it was constructed for.
+            */
+
+            typedef runtime_codec::erasure_pattern erasure_pattern;
+
+            explicit workspace(const std::size_t fec_length)
+            : fec_length     (fec_length    ),
+              syndrome       (fec_length    ),
+              lambda         (fec_length + 1),
+              omega          (fec_length    ),
+              error_locations(fec_length    ),
+              odd_sums       (fec_length    ),
+              erasure_key    (fec_length    ),
+              erasure_cache_entries(0),
+              erasure_cache_clock(0)
+            {
+               for (std::size_t i = 0; i < 5; ++i)
+               {
+                  scratch[i].resize(fec_length + 1);
+               }
+
+               for (std::size_t i = 0; i < static_cast<std::size_t>(erasure_cache_size); ++i)
+               {
+                  erasure_cache[i] = erasure_pattern(fec_length);
+               }
+            }
+
+            const std::size_t                 fec_length;
+            std::vector<galois::field_symbol> syndrome;
+            std::vector<galois::field_symbol> lambda;
+            std::vector<galois::field_symbol> omega;
+            std::vector<int>                  error_locations;
+            std::vector<galois::field_symbol> odd_sums;
+            std::vector<std::size_t>          erasure_key;
+            std::vector<galois::field_symbol> scratch[5];
+            erasure_pattern                   erasure_cache[erasure_cache_size];
+            std::size_t                       erasure_cache_entries;
+            std::size_t                       erasure_cache_clock;
+            details::erasure_cache_owner      erasure_cache_owner;
+         };
+
+         runtime_codec(const galois::field&            field,
+                       const std::size_t               code_length,
+                       const std::size_t               fec_length,
+                       const unsigned int              gen_initial_index = 0,
+                       const key_equation_solver::type solver = key_equation_solver::berlekamp_massey)
+         : field_(field),
+           code_length_(code_length),
+           fec_length_(fec_length),
+           gen_initial_index_(gen_initial_index),
+           generator_(make_generator(field, gen_initial_index, fec_length)),
+           encoder_(field, code_length, fec_length, generator_),
+           decoder_(field, code_length, fec_length, gen_initial_index, solver)
+         {}
+
+         inline bool valid() const
+         {
+            return encoder_.valid() && decoder_.valid();
+         }
+
+         inline const galois::field& field() const
+         {
+            return field_;
+         }
+
+         inline std::size_t code_length() const
+         {
+            return code_length_;
+         }
+
+         inline std::size_t fec_length() const
+         {
+            return fec_length_;
+         }
+
+         inline std::size_t data_length() const
+         {
+            return code_length_ - fec_length_;
+         }
+
+         inline unsigned int gen_initial_index() const
+         {
+            return gen_initial_index_;
+         }
+
+         inline key_equation_solver::type solver() const
+         {
+            return decoder_.solver();
+         }
+
+         inline const galois::field_polynomial& generator() const
+         {
+            return generator_;
+         }
+
+         inline bool encode(galois::field_symbol codeword[]) const
+         {
+            if (!valid())
+               return false;
+
+            encoder_.encode(codeword);
+
+            return true;
+         }
+
+         /*
+           The overloads without a workspace allocate one per call, those
+           decoding many codewords ought to pass their own workspace.
+         */
+         inline bool decode(galois::field_symbol codeword[], status& state) const
+         {
+            workspace ws(fec_length_);
+            return decode(codeword, empty_erasure_list(), state, ws);
+         }
+
+         inline bool decode(galois::field_symbol codeword[], const erasure_locations_t& erasure_list, status& state) const
+         {
+            workspace ws(fec_length_);
+            return decode(codeword, erasure_list, state, ws);
+         }
+
+         inline bool decode(galois::field_symbol       codeword[],
+                            const erasure_locations_t& erasure_list,
+                            status&                    state,
+                            workspace&                 ws) const
+         {
+            if ((!valid()) || (ws.fec_length != fec_length_))
+            {
+               state.errors_detected  = 0;
+               state.errors_corrected = 0;
+               state.zero_numerators  = 0;
+               state.unrecoverable    = true;
+               state.error            = status::e_decoder_error0;
+
+               return false;
+            }
+
+            return decoder_.decode(codeword, state, erasure_list, ws);
+         }
+
+         template <std::size_t block_length, std::size_t block_fec_length>
+         inline bool encode(block<block_length,block_fec_length>& rsblock) const
+         {
+            if ((!valid()) || (block_length != code_length_) || (block_fec_length != fec_length_))
+            {
+               rsblock.error = block<block_length,block_fec_length>::e_encoder_error0;
+               return false;
+            }
+
+            encoder_.encode(rsblock);
+
+            return true;
+         }
+
+         template <std::size_t block_length, std::size_t block_fec_length>
+         inline bool decode(block<block_length,block_fec_length>& rsblock) const
+         {
+            workspace ws(fec_length_);
+            return decode(rsblock, empty_erasure_list(), ws);
+         }
+
+         template <std::size_t block_length, std::size_t block_fec_length>
+         inline bool decode(block<block_length,block_fec_length>& rsblock, const erasure_locations_t& erasure_list) const
+         {
+            workspace ws(fec_length_);
+            return decode(rsblock, erasure_list, ws);
+         }
+
+         template <std::size_t block_length, std::size_t block_fec_length>
+         inline bool decode(block<block_length,block_fec_length>& rsblock,
+                            const erasure_locations_t&     erasure_list,
+                            workspace&                     ws) const
+         {
+            if ((!valid()) || (block_length != code_length_) || (block_fec_length != fec_length_) || (ws.fec_length != fec_length_))
+            {
+               rsblock.errors_detected  = 0;
+               rsblock.errors_corrected = 0;
+               rsblock.zero_numerators  = 0;
+               rsblock.unrecoverable    = true;
+               rsblock.error            = block<block_length,block_fec_length>::e_decoder_error0;
+
+               return false;
+            }
+
+            return decoder_.decode(rsblock, rsblock, erasure_list, ws);
+         }
+
+      private:
+
+         runtime_codec(const runtime_codec&);
+         runtime_codec& operator=(const runtime_codec&);
+
+         static galois::field_polynomial make_generator(const galois::field& field,
+                                                        const unsigned int   gen_initial_index,
+                                                        const std::size_t    fec_length)
+         {
+            /*
+              On failure the generator is left as the zero polynomial,
+              which the encoder core then deems invalid.
+            */
+
+            galois::field_polynomial generator(field);
+
+            make_sequential_root_generator_polynomial(field, gen_initial_index, fec_length, generator);
+
+            return generator;
+         }
+
+         const galois::field&           field_;
+         const std::size_t              code_length_;
+         const std::size_t              fec_length_;
+         const unsigned int             gen_initial_index_;
+         const galois::field_polynomial generator_;
+         const details::encoder_core    encoder_;
+         const details::decoder_core    decoder_;
+      };
+
+   } // namespace reed_solomon
+
+} // namespace schifra
+
+#endif
@@ -25,7 +25,11 @@
 
 int main()
 {
+   printf("CPU Level: %s\n",schifra::cpu::to_string(schifra::cpu::active_level()).c_str());
+
    schifra::reed_solomon::speed_test_00();
    schifra::reed_solomon::speed_test_01();
+   schifra::reed_solomon::speed_test_02();
+   schifra::reed_solomon::speed_test_03();
    return 0;
 }
@@ -36,6 +36,7 @@
 #include "schifra_reed_solomon_decoder.hpp"
 #include "schifra_reed_solomon_file_encoder.hpp"
 #include "schifra_reed_solomon_file_decoder.hpp"
+#include "schifra_reed_solomon_planner.hpp"
 #include "schifra_error_processes.hpp"
 #include "schifra_utilities.hpp"
 
@@ -162,7 +163,9 @@ namespace schifra
       {
       public:
 
-         all_errors_decoder_speed_test(const std::size_t prim_poly_size, const unsigned int prim_poly[])
+         all_errors_decoder_speed_test(const std::size_t prim_poly_size,
+                                       const unsigned int prim_poly[],
+                                       const key_equation_solver::type solver = key_equation_solver::berlekamp_massey)
          {
             galois::field field(field_descriptor,prim_poly_size,prim_poly);
             galois::field_polynomial generator_polynomial(field);
@@ -178,7 +181,7 @@ namespace schifra
             }
 
             RSEncoder rs_encoder(field,generator_polynomial);
-            RSDecoder rs_decoder(field,gen_poly_index);
+            RSDecoder rs_decoder(field,gen_poly_index,solver);
 
             std::vector< block<code_length,fec_length> > original_block;
 
@@ -205,6 +208,8 @@ namespace schifra
             std::size_t blocks_decoded       = 0;
             std::size_t block_failures       = 0;
 
+            typename RSDecoder::workspace workspace;
+
             schifra::utils::timer timer;
             timer.start();
 
@@ -212,7 +217,7 @@ namespace schifra
             {
                for (std::size_t i = 0; i < rs_block.size(); ++i)
                {
-                  if (!rs_decoder.decode(rs_block[i]))
+                  if (!rs_decoder.decode(rs_block[i],workspace))
                   {
                      std::cout << "Decoding Failure!" << std::endl;
                      block_failures++;
@@ -263,7 +268,9 @@ namespace schifra
       {
       public:
 
-         all_erasures_decoder_speed_test(const std::size_t prim_poly_size, const unsigned int prim_poly[])
+         all_erasures_decoder_speed_test(const std::size_t prim_poly_size,
+                                         const unsigned int prim_poly[],
+                                         const key_equation_solver::type solver = key_equation_solver::berlekamp_massey)
          {
             galois::field field(field_descriptor,prim_poly_size,prim_poly);
             galois::field_polynomial generator_polynomial(field);
@@ -279,7 +286,7 @@ namespace schifra
             }
 
             RSEncoder rs_encoder(field,generator_polynomial);
-            RSDecoder rs_decoder(field,gen_poly_index);
+            RSDecoder rs_decoder(field,gen_poly_index,solver);
 
             std::vector< block<code_length,fec_length> > original_block;
 
@@ -316,6 +323,8 @@ namespace schifra
             std::size_t blocks_decoded       =   0;
             std::size_t block_failures       =   0;
 
+            typename RSDecoder::workspace workspace;
+
             schifra::utils::timer timer;
             timer.start();
 
@@ -323,7 +332,7 @@ namespace schifra
             {
                for (std::size_t i = 0; i < rs_block.size(); ++i)
                {
-                  if (!rs_decoder.decode(rs_block[i],erasure_list[i]))
+                  if (!rs_decoder.decode(rs_block[i],erasure_list[i],workspace))
                   {
                      std::cout << "Decoding Failure!" << std::endl;
                      block_failures++;
@@ -364,6 +373,115 @@ namespace schifra
 
       };
 
+      template <std::size_t field_descriptor,
+                std::size_t gen_poly_index,
+                std::size_t code_length,
+                std::size_t fec_length,
+                std::size_t data_length = code_length - fec_length>
+      struct key_equation_solver_speed_test
+      {
+      public:
+
+         typedef block<code_length,fec_length> block_type;
+
+         key_equation_solver_speed_test(const std::size_t prim_poly_size,
+                                        const unsigned int prim_poly[],
+                                        const std::size_t erasure_count)
+         {
+            galois::field field(field_descriptor,prim_poly_size,prim_poly);
+            galois::field_polynomial generator_polynomial(field);
+
+            if (
+                 !make_sequential_root_generator_polynomial(field,
+                                                            gen_poly_index,
+                                                            fec_length,
+                                                            generator_polynomial)
+               )
+            {
+               return;
+            }
+
+            encoder<code_length,fec_length> rs_encoder(field,generator_polynomial);
+
+            std::vector<block_type> original_block;
+
+            create_messages<code_length,fec_length>(rs_encoder,original_block);
+
+            std::vector<block_type> rs_block;
+            std::vector<erasure_locations_t> erasure_list;
+            std::vector<std::size_t> block_index_list;
+
+            for (std::size_t block_index = 0; block_index < original_block.size(); ++block_index)
+            {
+               for (std::size_t start_position = 0; start_position < code_length; ++start_position)
+               {
+                  block_type block = original_block[block_index];
+                  erasure_locations_t erasures;
+
+                  corrupt_message_errors_erasures(block,error_mode::erasures_errors,start_position,erasure_count,erasures);
+
+                  rs_block.push_back(block);
+                  erasure_list.push_back(erasures);
+                  block_index_list.push_back(block_index);
+               }
+            }
+
+            printf("[Key Equation Solver Test] Codec: RS(%03d,%03d,%03d) Erasures: %03d ",
+                   static_cast<int>(code_length),
+                   static_cast<int>(data_length),
+                   static_cast<int>(fec_length),
+                   static_cast<int>(erasure_count));
+
+            const key_equation_solver::type solver_list[] =
+                                               {
+                                                 key_equation_solver::berlekamp_massey,
+                                                 key_equation_solver::inversionless_berlekamp_massey,
+                                                 key_equation_solver::euclidean
+                                               };
+
+            const std::size_t solver_list_size = sizeof(solver_list) / sizeof(key_equation_solver::type);
+
+            for (std::size_t s = 0; s < solver_list_size; ++s)
+            {
+               decoder<code_length,fec_length> rs_decoder(field,gen_poly_index,solver_list[s]);
+
+               const std::size_t max_iterations = 10;
+               std::size_t block_failures       =  0;
+
+               schifra::utils::timer timer;
+               timer.start();
+
+               for (std::size_t j = 0; j < max_iterations; ++j)
+               {
+                  for (std::size_t i = 0; i < rs_block.size(); ++i)
+                  {
+                     block_type block = rs_block[i];
+
+                     if (
+                          !rs_decoder.decode(block,erasure_list[i]) ||
+                          !are_blocks_equivelent(block,original_block[block_index_list[i]])
+                        )
+                     {
+                        block_failures++;
+                     }
+                  }
+               }
+
+               timer.stop();
+
+               double time = timer.time();
+               double mbps = ((max_iterations * rs_block.size() * data_length) * 8.0) / (1048576.0 * time);
+
+               printf("%s:%9.3fMbps%s ",
+                      key_equation_solver::to_string(solver_list[s]).c_str(),
+                      mbps,
+                      (block_failures ? "(Failures)" : ""));
+            }
+
+            printf("\n");
+         }
+      };
+
       void speed_test_00()
       {
          all_errors_decoder_speed_test<8,120,255,  2>(galois::primitive_polynomial_size06,galois::primitive_polynomial06);
@@ -404,6 +522,81 @@ namespace schifra
          all_erasures_decoder_speed_test<8,120,255,128>(galois::primitive_polynomial_size06,galois::primitive_polynomial06);
       }
 
+      template <std::size_t field_descriptor, std::size_t gen_poly_index, std::size_t code_length, std::size_t fec_length>
+      void key_equation_solver_speed_test_set(const std::size_t prim_poly_size, const unsigned int prim_poly[])
+      {
+         /*
+            Compare the key equation solvers for a given code over an
+            increasing erasure load, with the remaining capacity of the
+            code consumed by errors.
+         */
+         for (std::size_t i = 0; i <= 4; ++i)
+         {
+            key_equation_solver_speed_test<field_descriptor,gen_poly_index,code_length,fec_length>
+               (prim_poly_size,prim_poly,(i * fec_length) / 4);
+         }
+      }
+
+      void speed_test_02()
+      {
+         key_equation_solver_speed_test_set<8,120,255, 16>(galois::primitive_polynomial_size06,galois::primitive_polynomial06);
+         key_equation_solver_speed_test_set<8,120,255, 32>(galois::primitive_polynomial_size06,galois::primitive_polynomial06);
+         key_equation_solver_speed_test_set<8,120,255, 64>(galois::primitive_polynomial_size06,galois::primitive_polynomial06);
+      }
+
+      void speed_test_03()
+      {
+         /*
+            Plan a set of codes, save the resulting wisdom and then load
+            it into a fresh planner, which must then hold the very same
+            plans without having to measure anything.
+         */
+
+         const galois::field field(8,galois::primitive_polynomial_size06,galois::primitive_polynomial06);
+
+         const std::size_t code_length  = 255;
+         const std::size_t fec_length[] = { 2, 8, 16, 32, 64 };
+         const std::size_t fec_count    = sizeof(fec_length) / sizeof(std::size_t);
+         const std::string wisdom_file  = "schifra_reed_solomon_planner.wisdom";
+
+         planner rs_planner;
+
+         for (std::size_t i = 0; i < fec_count; ++i)
+         {
+            printf("[planner] Code: RS(%3d,%3d) Plan: %s\n",
+                   static_cast<int>(code_length),
+                   static_cast<int>(code_length - fec_length[i]),
+                   key_equation_solver::to_string(rs_planner.solver(field,code_length,fec_length[i],120)).c_str());
+         }
+
+         planner loaded_planner;
+
+         if (!rs_planner.save(wisdom_file) || !loaded_planner.load(wisdom_file))
+         {
+            printf("[planner] Error - Failed to save/load wisdom file: %s\n",wisdom_file.c_str());
+            return;
+         }
+
+         for (std::size_t i = 0; i < fec_count; ++i)
+         {
+            planner::plan original_plan;
+            planner::plan loaded_plan;
+
+            if (
+                 !rs_planner    .find(field.pwr(),code_length,fec_length[i],120,original_plan) ||
+                 !loaded_planner.find(field.pwr(),code_length,fec_length[i],120,loaded_plan  ) ||
+                 (original_plan.solver != loaded_plan.solver)
+               )
+            {
+               printf("[planner] Error - Loaded plan mismatch for RS(%3d,%3d)\n",
+                      static_cast<int>(code_length),
+                      static_cast<int>(code_length - fec_length[i]));
+            }
+         }
+
+         std::remove(wisdom_file.c_str());
+      }
+
    } // namespace reed_solomon
 
 } // namespace schifra
@@ -58,13 +58,12 @@ class erasure_process
 public:
 
    erasure_process(const unsigned int& process_id,
-                   schifra::galois::field& field,
-                   schifra::galois::field_polynomial& generator_polynomial,
-                   const std::size_t& generator_polynomial_index)
+                   const Encoder& encoder,
+                   const Decoder& decoder)
    : process_id_(process_id),
      total_time_(0.0),
-     encoder_(field,generator_polynomial),
-     decoder_(field,generator_polynomial_index)
+     encoder_(encoder),
+     decoder_(decoder)
    {}
 
    erasure_process& operator=(const erasure_process& ep)
@@ -92,6 +91,9 @@ public:
       unsigned char send_data[data_size];
       unsigned char recv_data[data_size];
 
+      /* The decoder is shared by all the processes, each with its own workspace */
+      typename Decoder::workspace workspace;
+
       schifra::utils::timer timer;
       total_time_ = 0.0;
 
@@ -120,7 +122,7 @@ public:
             missing_row_index.push_back(missing_index);
          }
 
-         schifra::reed_solomon::erasure_channel_stack_decode<code_length,fec_length>(decoder_,missing_row_index,block_stack);
+         schifra::reed_solomon::erasure_channel_stack_decode<code_length,fec_length>(decoder_,missing_row_index,block_stack,workspace);
 
          schifra::reed_solomon::copy<unsigned char,code_length,fec_length,stack_size>(block_stack,recv_data);
 
@@ -142,8 +144,8 @@ private:
 
    unsigned int process_id_;
    double total_time_;
-   Encoder encoder_;
-   Decoder decoder_;
+   const Encoder& encoder_;
+   const Decoder& decoder_;
 };
 
 int main()
@@ -182,6 +184,10 @@ int main()
    typedef erasure_process<encoder_type,decoder_type> erasure_process_type;
    typedef boost::shared_ptr<erasure_process_type>    erasure_process_ptr_type;
 
+   /* Instantiate Encoder and Decoder (Codec), to be shared by all the threads */
+   encoder_type encoder(field,generator_polynomial);
+   decoder_type decoder(field,generator_polynomial_index);
+
    const unsigned int max_thread_count = 4; // number of functional cores.
 
    std::vector<erasure_process_ptr_type> erasure_process_list;
@@ -194,9 +200,8 @@ int main()
                                      erasure_process_type
                                      (
                                        i,
-                                       field,
-                                       generator_polynomial,
-                                       generator_polynomial_index
+                                       encoder,
+                                       decoder
                                      )));
 
       threads.create_thread(boost::bind(&erasure_process_type::execute,erasure_process_list[i]));